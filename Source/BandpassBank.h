@@ -0,0 +1,161 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+/**
+ * BandpassBank - the DubDelay feedback bandpass (12/24 dB) as one filter bank
+ *
+ * Both cascade stages run at the same FREQ/BW, so they share one set of
+ * coefficients, computed once per parameter change. State is kept in
+ * structure-of-arrays form: one SIMD register per state variable per stage,
+ * lane 0 = L and lane 1 = R, so one update filters both channels.
+ *
+ * Two selectable topologies realise the same transfer function - the
+ * analog prototype H(s) = s / (s^2 + s/Q + 1), bilinear-transformed with
+ * prewarping at f0 (peak gain = Q, which the feedback loop relies on):
+ * - svf:    TPT state-variable, same math as juce::dsp::StateVariableTPTFilter
+ *           (well behaved under fast FREQ/BW modulation)
+ * - biquad: RBJ cookbook BPF "constant skirt gain" (Audio-EQ-Cookbook.txt),
+ *           transposed direct form II - fewer operations per sample
+ *
+ * Coefficients are set from the prewarped cutoff g = tan(pi fc / fs) and the
+ * damping R2 = 1 / Q (see CoefficientTables), so an update never calls tan();
+ * the biquad terms follow from g (sin w0 = 2g / (1 + g^2), cos w0 =
+ * (1 - g^2) / (1 + g^2)).
+ *
+ * The block variant runs one stage at a time over the whole block with the
+ * state held in locals, so each pass is a tight, fully inlined loop.
+ */
+template <typename SampleType>
+class BandpassBank
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<SampleType>;
+
+    enum class Topology
+    {
+        svf = 0,
+        biquad
+    };
+
+    static constexpr int MAX_STAGES = 2;
+
+    void reset()
+    {
+        for (int stage = 0; stage < MAX_STAGES; ++stage)
+        {
+            s1[stage] = SampleType(0);
+            s2[stage] = SampleType(0);
+        }
+    }
+
+    void setPrewarpedCutoff(double newG) { g = newG; updateCoefficients(); }    // tan(pi fc / fs)
+    void setDamping(double newR2) { R2 = newR2; updateCoefficients(); }         // 1 / Q
+
+    // The two topologies keep different state variables - switching starts clean
+    void setTopology(Topology newTopology)
+    {
+        if (newTopology == topology)
+            return;
+
+        topology = newTopology;
+        reset();
+    }
+
+    Topology getTopology() const { return topology; }
+
+    template <bool TwoStages>
+    Lanes processSample(Lanes x) noexcept
+    {
+        if (topology == Topology::biquad)
+        {
+            x = tickBiquad(x, s1[0], s2[0]);
+            if constexpr (TwoStages)
+                x = tickBiquad(x, s1[1], s2[1]);
+        }
+        else
+        {
+            x = tickSVF(x, s1[0], s2[0]);
+            if constexpr (TwoStages)
+                x = tickSVF(x, s1[1], s2[1]);
+        }
+
+        return x;
+    }
+
+    // In place over a block of frames, one pass per stage
+    template <bool TwoStages>
+    void process(Lanes* frames, int numSamples) noexcept
+    {
+        constexpr int numStages = TwoStages ? 2 : 1;
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            Lanes state1 = s1[stage];
+            Lanes state2 = s2[stage];
+
+            if (topology == Topology::biquad)
+                for (int i = 0; i < numSamples; ++i) frames[i] = tickBiquad(frames[i], state1, state2);
+            else
+                for (int i = 0; i < numSamples; ++i) frames[i] = tickSVF(frames[i], state1, state2);
+
+            s1[stage] = state1;
+            s2[stage] = state2;
+        }
+    }
+
+private:
+    // TPT SVF bandpass output (operation order as in StateVariableTPTFilter)
+    Lanes tickSVF(Lanes x, Lanes& state1, Lanes& state2) const noexcept
+    {
+        const Lanes yHP = svfH * (x - state1 * svfGPlusR2 - state2);
+        const Lanes yBP = yHP * svfG + state1;
+        state1 = yHP * svfG + yBP;
+        const Lanes yLP = yBP * svfG + state2;
+        state2 = yBP * svfG + yLP;
+        return yBP;
+    }
+
+    // Transposed direct form II, b1 = 0 and b2 = -b0 for the BPF
+    Lanes tickBiquad(Lanes x, Lanes& state1, Lanes& state2) const noexcept
+    {
+        const Lanes y = x * bqB0 + state1;
+        state1 = state2 - y * bqA1;
+        state2 = x * bqB2 - y * bqA2;
+        return y;
+    }
+
+    void updateCoefficients()
+    {
+        // SVF: same rounding as StateVariableTPTFilter::update()
+        const auto gValue = static_cast<SampleType>(g);
+        const auto R2Value = static_cast<SampleType>(R2);
+        svfG = gValue;
+        svfGPlusR2 = gValue + R2Value;
+        svfH = static_cast<SampleType>(1.0 / (1.0 + R2Value * gValue + gValue * gValue));
+
+        // Cookbook BPF, constant skirt gain: b0 = sin(w0)/2, b2 = -b0, normalised by a0
+        const double gSquared = g * g;
+        const double sinW0 = 2.0 * g / (1.0 + gSquared);
+        const double cosW0 = (1.0 - gSquared) / (1.0 + gSquared);
+        const double alpha = sinW0 * R2 / 2.0;
+        const double a0 = 1.0 + alpha;
+        bqB0 = static_cast<SampleType>(sinW0 / 2.0 / a0);
+        bqB2 = static_cast<SampleType>(-sinW0 / 2.0 / a0);
+        bqA1 = static_cast<SampleType>(-2.0 * cosW0 / a0);
+        bqA2 = static_cast<SampleType>((1.0 - alpha) / a0);
+    }
+
+    Topology topology = Topology::svf;
+    double g = 0.0;                                      // Prewarped cutoff
+    double R2 = juce::MathConstants<double>::sqrt2;      // Damping, Q = 1/sqrt2
+
+    // Shared coefficients (broadcast to every lane)
+    Lanes svfG {}, svfGPlusR2 {}, svfH {};
+    Lanes bqB0 {}, bqB2 {}, bqA1 {}, bqA2 {};
+
+    // Per-stage state, SoA: s1[stage] / s2[stage] hold both channels
+    Lanes s1[MAX_STAGES] {};
+    Lanes s2[MAX_STAGES] {};
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+/**
+ * BinaryState - compact versioned plugin state
+ *
+ * getStateInformation() used to go through copyState() -> XmlElement ->
+ * copyXmlToBinary() and back, allocating a tree and parsing text for every
+ * instance in a session. This writes the parameters straight into one
+ * packed block and reads them straight back into the parameters.
+ *
+ * Layout (little-endian):
+ *   header   uint32 MAGIC, uint16 version, uint16 header size in bytes,
+ *            uint16 entry count, uint16 current program
+ *   entries  count x { uint32 key, float32 value }
+ *
+ * key is the FNV-1a hash of the ParameterID string, so it is stable across
+ * builds and parameter order; value is the plain (denormalised) value, so a
+ * later range change still restores the same setting. Readers skip header
+ * bytes they don't know (header size) and entries with unknown keys;
+ * parameters missing from a state go back to their defaults.
+ *
+ * One instance per processor, built after the parameters exist. read()
+ * does not allocate (its scratch is sized in the constructor).
+ */
+class BinaryState
+{
+public:
+    static constexpr juce::uint32 MAGIC = 0x5342444bu;  // "KDBS"
+    static constexpr juce::uint16 VERSION = 1;
+    static constexpr int HEADER_SIZE = 12;
+    static constexpr int ENTRY_SIZE = 8;
+
+    explicit BinaryState(const juce::Array<juce::AudioProcessorParameter*>& parameters)
+    {
+        for (auto* parameter : parameters)
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+                entries.push_back({ keyFor(ranged->paramID), ranged });
+
+        std::sort(entries.begin(), entries.end(),
+                  [] (const Entry& a, const Entry& b) { return a.key < b.key; });
+
+        // Two IDs hashing to the same key would make states ambiguous
+        jassert(std::adjacent_find(entries.begin(), entries.end(),
+                                   [] (const Entry& a, const Entry& b) { return a.key == b.key; }) == entries.end());
+
+        restored.resize(entries.size());
+    }
+
+    // 32-bit FNV-1a of the ID's UTF-8 bytes
+    static juce::uint32 keyFor(const juce::String& parameterID) noexcept
+    {
+        juce::uint32 hash = 2166136261u;
+        for (auto* c = parameterID.toRawUTF8(); *c != 0; ++c)
+            hash = (hash ^ static_cast<juce::uint8>(*c)) * 16777619u;
+        return hash;
+    }
+
+    static bool isBinaryState(const void* data, int sizeInBytes) noexcept
+    {
+        return data != nullptr && sizeInBytes >= HEADER_SIZE && readUint32(data, 0) == MAGIC;
+    }
+
+    void write(juce::MemoryBlock& destData, int program) const
+    {
+        const auto size = static_cast<size_t>(HEADER_SIZE + ENTRY_SIZE * static_cast<int>(entries.size()));
+        destData.setSize(size);
+        auto* out = destData.getData();
+
+        writeUint32(out, 0, MAGIC);
+        writeUint16(out, 4, VERSION);
+        writeUint16(out, 6, static_cast<juce::uint16>(HEADER_SIZE));
+        writeUint16(out, 8, static_cast<juce::uint16>(entries.size()));
+        writeUint16(out, 10, static_cast<juce::uint16>(program));
+
+        size_t offset = HEADER_SIZE;
+        for (const auto& entry : entries)
+        {
+            writeUint32(out, offset, entry.key);
+            writeFloat(out, offset + 4, entry.parameter->convertFrom0to1(entry.parameter->getValue()));
+            offset += ENTRY_SIZE;
+        }
+    }
+
+    // Applies a state from write() to the parameters (host notified as for
+    // any change). Returns false, leaving everything untouched, for data
+    // that isn't a complete state of a known version. program receives the
+    // stored program index.
+    bool read(const void* data, int sizeInBytes, int& program)
+    {
+        if (! isBinaryState(data, sizeInBytes) || readUint16(data, 4) > VERSION)
+            return false;
+
+        const int headerSize = readUint16(data, 6);
+        const int count = readUint16(data, 8);
+        if (headerSize < HEADER_SIZE || headerSize + count * ENTRY_SIZE > sizeInBytes)
+            return false;
+
+        program = readUint16(data, 10);
+        std::fill(restored.begin(), restored.end(), false);
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto offset = static_cast<size_t>(headerSize + i * ENTRY_SIZE);
+            const auto key = readUint32(data, offset);
+            const auto found = std::lower_bound(entries.begin(), entries.end(), key,
+                                                [] (const Entry& entry, juce::uint32 k) { return entry.key < k; });
+
+            if (found == entries.end() || found->key != key)
+                continue;  // Parameter from a newer version
+
+            auto* parameter = found->parameter;
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(readFloat(data, offset + 4)));
+            restored[static_cast<size_t>(found - entries.begin())] = true;
+        }
+
+        // Added since the state was written: back to the default
+        for (size_t i = 0; i < entries.size(); ++i)
+            if (! restored[i])
+                entries[i].parameter->setValueNotifyingHost(entries[i].parameter->getDefaultValue());
+
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        juce::uint32 key;
+        juce::RangedAudioParameter* parameter;
+    };
+
+    static void writeUint16(void* out, size_t offset, juce::uint16 value) noexcept
+    {
+        const auto le = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(static_cast<char*>(out) + offset, &le, sizeof(le));
+    }
+
+    static void writeUint32(void* out, size_t offset, juce::uint32 value) noexcept
+    {
+        const auto le = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(static_cast<char*>(out) + offset, &le, sizeof(le));
+    }
+
+    static void writeFloat(void* out, size_t offset, float value) noexcept
+    {
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUint32(out, offset, bits);
+    }
+
+    static juce::uint16 readUint16(const void* data, size_t offset) noexcept
+    {
+        juce::uint16 value;
+        std::memcpy(&value, static_cast<const char*>(data) + offset, sizeof(value));
+        return juce::ByteOrder::swapIfBigEndian(value);
+    }
+
+    static juce::uint32 readUint32(const void* data, size_t offset) noexcept
+    {
+        juce::uint32 value;
+        std::memcpy(&value, static_cast<const char*>(data) + offset, sizeof(value));
+        return juce::ByteOrder::swapIfBigEndian(value);
+    }
+
+    static float readFloat(const void* data, size_t offset) noexcept
+    {
+        const auto bits = readUint32(data, offset);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::vector<Entry> entries;             // Sorted by key
+    std::vector<bool> restored;             // read() scratch, one flag per entry
+
+    JUCE_DECLARE_NON_COPYABLE(BinaryState)
+};
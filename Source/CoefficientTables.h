@@ -0,0 +1,123 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * CoefficientTables - precomputed filter coefficient terms for one sample rate
+ *
+ * FREQ moves in 1 Hz steps (300-3000 Hz), BANDW in 0.01 steps (0-4) and the
+ * degrade cutoff is a clamped map of the delay time (2000-15000 Hz). Every
+ * change used to cost a tan() per filter; with the terms tabulated, a
+ * coefficient update is a lookup plus the filter's own normalisation.
+ *
+ * - prewarp(): g = tan(pi fc / fs) for 300-15000 Hz at 1 Hz steps (covers
+ *   the bandpass, degrade and feedback lowpasses). Whole-Hz cutoffs are exact
+ *   table entries; fractional ones interpolate between neighbours.
+ * - damping(): R2 = 1 / Q for every BANDW step, Q mapped as in DubDelay.
+ *   Off-grid values fall back to the direct math.
+ *
+ * Tables are read-only once built and shared by every instance running at
+ * the same sample rate (getShared(), called from prepare() - it builds on
+ * first use, so never call it on the audio thread).
+ */
+class CoefficientTables
+{
+public:
+    static constexpr int MIN_CUTOFF_HZ = 300;
+    static constexpr int MAX_CUTOFF_HZ = 15000;
+    static constexpr int BANDWIDTH_STEPS = 400;          // BANDW 0.0-4.0 in 0.01 steps
+    static constexpr float BANDWIDTH_STEP = 0.01f;
+
+    explicit CoefficientTables(double newSampleRate)
+        : sampleRate(newSampleRate)
+    {
+        prewarpTable.resize(static_cast<size_t>(MAX_CUTOFF_HZ - MIN_CUTOFF_HZ + 1));
+        for (size_t i = 0; i < prewarpTable.size(); ++i)
+            prewarpTable[i] = computePrewarp(static_cast<float>(MIN_CUTOFF_HZ + static_cast<int>(i)));
+
+        dampingTable.resize(static_cast<size_t>(BANDWIDTH_STEPS + 1));
+        for (size_t i = 0; i < dampingTable.size(); ++i)
+            dampingTable[i] = computeDamping(bandwidthForStep(static_cast<int>(i)));
+    }
+
+    // One copy per sample rate for the whole process. Instances hold the
+    // pointer, so a rate's tables live exactly as long as something uses them.
+    static std::shared_ptr<const CoefficientTables> getShared(double sampleRate)
+    {
+        static std::mutex cacheLock;
+        static std::map<double, std::weak_ptr<const CoefficientTables>> cache;
+
+        const std::lock_guard<std::mutex> lock(cacheLock);
+
+        auto& entry = cache[sampleRate];
+        auto tables = entry.lock();
+        if (tables == nullptr)
+        {
+            tables = std::make_shared<const CoefficientTables>(sampleRate);
+            entry = tables;
+            DBG("CoefficientTables: built for sampleRate=" + juce::String(sampleRate));
+        }
+
+        return tables;
+    }
+
+    double getSampleRate() const noexcept { return sampleRate; }
+
+    // g = tan(pi fc / fs), the prewarped cutoff of the TPT SVF and bilinear biquad
+    double prewarp(float cutoff) const noexcept
+    {
+        const float position = cutoff - static_cast<float>(MIN_CUTOFF_HZ);
+        if (position >= 0.0f && position <= static_cast<float>(MAX_CUTOFF_HZ - MIN_CUTOFF_HZ))
+        {
+            const auto index = static_cast<size_t>(position);
+            const double fraction = position - static_cast<float>(index);
+            if (fraction == 0.0)
+                return prewarpTable[index];
+
+            return prewarpTable[index] + fraction * (prewarpTable[index + 1] - prewarpTable[index]);
+        }
+
+        return computePrewarp(cutoff);
+    }
+
+    // R2 = 1 / Q for a BANDW value (0.0-4.0)
+    double damping(float bandwidth) const noexcept
+    {
+        const auto step = static_cast<int>(std::lround(bandwidth / BANDWIDTH_STEP));
+        if (step >= 0 && step <= BANDWIDTH_STEPS && bandwidth == bandwidthForStep(step))
+            return dampingTable[static_cast<size_t>(step)];
+
+        return computeDamping(bandwidth);
+    }
+
+    // BANDW 0.0-4.0 -> resonance (Q) 0.5-5.0
+    static float bandwidthToResonance(float bandwidth) noexcept
+    {
+        return juce::jmap(bandwidth, 0.0f, 4.0f, 0.5f, 5.0f);
+    }
+
+private:
+    // Same value the parameter snaps to (start + interval * steps)
+    static float bandwidthForStep(int step) noexcept { return BANDWIDTH_STEP * static_cast<float>(step); }
+
+    double computePrewarp(float cutoff) const noexcept
+    {
+        return std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+    }
+
+    static double computeDamping(float bandwidth) noexcept
+    {
+        return 1.0 / bandwidthToResonance(bandwidth);
+    }
+
+    double sampleRate;
+    std::vector<double> prewarpTable;   // [cutoff - MIN_CUTOFF_HZ]
+    std::vector<double> dampingTable;   // [BANDW / BANDWIDTH_STEP]
+
+    JUCE_DECLARE_NON_COPYABLE(CoefficientTables)
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+/**
+ * DspLoadMonitor - per-instance processing time against the real-time budget
+ *
+ * The audio thread records each block's load (processing time / block
+ * duration) into a ring of the last HISTORY_SIZE blocks, plus running
+ * counters, with relaxed atomic stores only. getStats() summarises the ring
+ * on the reading side (the editor's performance HUD timer) - an entry being
+ * overwritten mid-read only shifts the window by one block.
+ */
+class DspLoadMonitor
+{
+public:
+    static constexpr int HISTORY_SIZE = 1024;
+    static constexpr float OVER_BUDGET_LOAD = 0.5f;  // Counted as "heavy" above 50% of the budget
+
+    struct Stats
+    {
+        int numBlocks = 0;                  // Blocks in the window (up to HISTORY_SIZE)
+        float minLoad = 0.0f;               // Fractions of the block's real-time budget
+        float meanLoad = 0.0f;
+        float p99Load = 0.0f;
+        float maxLoad = 0.0f;
+        juce::uint64 totalBlocks = 0;
+        juce::uint32 blocksOverBudget = 0;  // All blocks so far above OVER_BUDGET_LOAD
+        juce::uint32 resetCount = 0;
+        int enginePath = 0;                 // DubDelay::EnginePath of the last block
+    };
+
+    // Audio thread
+    void recordBlock(double elapsedSeconds, int numSamples, double sampleRate, int enginePath) noexcept
+    {
+        if (numSamples <= 0 || sampleRate <= 0.0)
+            return;
+
+        const auto load = static_cast<float>(elapsedSeconds * sampleRate / numSamples);
+        const auto count = blockCount.load(std::memory_order_relaxed);
+
+        loads[static_cast<size_t>(count % HISTORY_SIZE)].store(load, std::memory_order_relaxed);
+        lastEnginePath.store(enginePath, std::memory_order_relaxed);
+
+        if (load > OVER_BUDGET_LOAD)
+            overBudgetCount.store(overBudgetCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        blockCount.store(count + 1, std::memory_order_release);
+    }
+
+    void recordReset() noexcept
+    {
+        resetCount.store(resetCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Reading side (message thread)
+    Stats getStats() const
+    {
+        Stats stats;
+        stats.totalBlocks = blockCount.load(std::memory_order_acquire);
+        stats.blocksOverBudget = overBudgetCount.load(std::memory_order_relaxed);
+        stats.resetCount = resetCount.load(std::memory_order_relaxed);
+        stats.enginePath = lastEnginePath.load(std::memory_order_relaxed);
+        stats.numBlocks = static_cast<int>(std::min<juce::uint64>(stats.totalBlocks, HISTORY_SIZE));
+
+        if (stats.numBlocks == 0)
+            return stats;
+
+        std::array<float, HISTORY_SIZE> window;
+        double sum = 0.0;
+        for (int i = 0; i < stats.numBlocks; ++i)
+        {
+            window[static_cast<size_t>(i)] = loads[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+            sum += window[static_cast<size_t>(i)];
+        }
+
+        const auto begin = window.begin();
+        const auto end = begin + stats.numBlocks;
+        const auto p99 = begin + (stats.numBlocks * 99) / 100;
+        std::nth_element(begin, p99, end);
+
+        stats.p99Load = *p99;
+        stats.minLoad = *std::min_element(begin, end);
+        stats.maxLoad = *std::max_element(begin, end);
+        stats.meanLoad = static_cast<float>(sum / stats.numBlocks);
+        return stats;
+    }
+
+private:
+    std::array<std::atomic<float>, HISTORY_SIZE> loads {};
+    std::atomic<juce::uint64> blockCount { 0 };
+    std::atomic<juce::uint32> overBudgetCount { 0 };
+    std::atomic<juce::uint32> resetCount { 0 };
+    std::atomic<int> lastEnginePath { 0 };
+};
@@ -1,212 +1,1694 @@
 #include "DubDelay.h"
 #include <cmath>
+#include <type_traits>
 
-DubDelay::DubDelay()
+template <typename SampleType>
+void DubDelay<SampleType>::LaneSVF::update(double newG)
 {
-    // Initialize filters as bandpass
-    filterL1.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    filterR1.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    filterL2.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    filterR2.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+    // Same coefficient math as juce::dsp::StateVariableTPTFilter::update()
+    const auto gValue = static_cast<SampleType>(newG);
+    const auto R2Value = static_cast<SampleType>(1.0 / RESONANCE);
+    g = gValue;
+    R2 = R2Value;
+    h = static_cast<SampleType>(1.0 / (1.0 + R2Value * gValue + gValue * gValue));
+}
+
+template <typename SampleType>
+DubDelay<SampleType>::DubDelay()
+    : coefficientTables(CoefficientTables::getShared(currentSampleRate))
+{
+    // Degradation lowpass, and the feedback-path LPF (darkens repeats - issue #4)
+    for (int group = 0; group < MAX_GROUPS; ++group)
+    {
+        degradeLP[static_cast<size_t>(group)].setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+        feedbackLP[static_cast<size_t>(group)].setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    }
+
+    // Every channel feeds back its own repeat; crossfeed starts off
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel)
+        crossfeedColumns[static_cast<size_t>(channel)][static_cast<size_t>(channel / LANES)].set(static_cast<size_t>(channel % LANES), 1);
+    setPingPongRing({ 0, 1 });
+
+    updateFilterCoefficients();
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::prepare(double sampleRate, int samplesPerBlock, int numChannelsToPrepare)
+{
+    currentSampleRate = sampleRate;
+    maxBlockSize = std::max(1, samplesPerBlock);
+
+    // Mono hosts can still hand over stereo, so there are always two rings
+    preparedChannels = std::clamp(numChannelsToPrepare, 2, MAX_CHANNELS);
+
+    // Ring buffers: 4 s (plus the wow/flutter stretch) at the real sample rate,
+    // rounded up to a power of two. Only reallocate when the sample rate
+    // changes the required capacity (or the channel count adds a ring).
+    const int maxDelaySamples = static_cast<int>(std::ceil(MAX_DELAY_MS * (1.0f + WowFlutter::MAX_DEVIATION) * sampleRate / 1000.0));
+    const int capacity = juce::nextPowerOfTwo(maxDelaySamples + SINC_MARGIN);
+    bool reallocated = false;
+
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel)
+    {
+        auto& ring = delayBuffers[static_cast<size_t>(channel)];
+
+        if (channel >= preparedChannels)
+            std::vector<SampleType>().swap(ring);
+        else if (static_cast<int>(ring.size()) != capacity)
+        {
+            ring.assign(static_cast<size_t>(capacity), 0.0f);
+            reallocated = true;
+        }
+    }
+
+    if (reallocated)
+    {
+        delayMask = capacity - 1;
+        writePos = 0;
+    }
+
+    // The reset() below leaves every prepared ring clean (masked)
+    ringChannels = preparedChannels;
+
+    // Pans spread over all channels until told otherwise
+    std::vector<int> ring;
+    for (int channel = 0; channel < preparedChannels; ++channel)
+        ring.push_back(channel);
+    setPingPongRing(ring);
+
+    resetFadeLength = std::max(1, static_cast<int>(RESET_FADE_MS * sampleRate / 1000.0));
+    crossfadeLength = std::max(1, static_cast<int>(CROSSFADE_MS * sampleRate / 1000.0));
+
+    // Delay time in samples depends on the sample rate - force the next
+    // setDelayTime() / setTap() through change detection
+    lastTimeValue = UNSET;
+    for (auto& tap : extraTaps)
+        tap.noteValue = UNSET;
+
+    // Scratch for the staged engine (larger host blocks are processed in chunks)
+    const auto scratchFrames = static_cast<size_t>(maxBlockSize * groupCount(preparedChannels));
+    wetScratch.assign(scratchFrames, Lanes {});
+    feedbackScratch.assign(scratchFrames, Lanes {});
+    modulationScratch.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    wowFlutter.prepare(sampleRate);
+
+    // Build the shared sinc table now rather than on the first offline read
+    typename WindowedSinc<SampleType>::Weights sincWarmup;
+    WindowedSinc<SampleType>::weights(SampleType(0), sincWarmup);
+
+    // Softclip oversamplers (polyphase IIR halfband, integer latency so the
+    // loop compensation stays a whole number of samples). Both are built here
+    // so switching quality on the audio thread never allocates.
+    oversampler2x = std::make_unique<juce::dsp::Oversampling<SampleType>>(
+        static_cast<size_t>(preparedChannels), 1, juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR, true, true);
+    oversampler4x = std::make_unique<juce::dsp::Oversampling<SampleType>>(
+        static_cast<size_t>(preparedChannels), 2, juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR, true, true);
+    oversampler2x->initProcessing(static_cast<size_t>(maxBlockSize));
+    oversampler4x->initProcessing(static_cast<size_t>(maxBlockSize));
+    saturationScratch.setSize(preparedChannels, maxBlockSize);
+
+    const int maxLoopLatency = static_cast<int>(std::max(oversampler2x->getLatencyInSamples(),
+                                                         oversampler4x->getLatencyInSamples()));
+    dryCompensation.assign(static_cast<size_t>(juce::nextPowerOfTwo(maxLoopLatency + 1) * MAX_GROUPS), Lanes {});
+    updateLoopLatency();
+
+    // Filter coefficients for this rate (tables shared with other instances)
+    if (coefficientTables->getSampleRate() != sampleRate)
+        coefficientTables = CoefficientTables::getShared(sampleRate);
+    updateFilterCoefficients();
+
+    // Log DSP config (once per init - see domain.md)
+    DBG("DubDelay::prepare() - sampleRate=" + juce::String(sampleRate)
+        + " maxBlockSize=" + juce::String(maxBlockSize)
+        + " channels=" + juce::String(preparedChannels)
+        + " delayCapacity=" + juce::String(delayMask + 1)
+        + " lanes=" + juce::String(static_cast<int>(Lanes::size()))
+        + " FB_WRITE_LIMIT=" + juce::String(FB_WRITE_LIMIT)
+        + " FEEDBACK_LPF_FREQ=" + juce::String(FEEDBACK_LPF_FREQ)
+        + " saturationQuality=" + juce::String(static_cast<int>(saturationQuality))
+        + " renderQuality=" + juce::String(static_cast<int>(pendingRenderQuality))
+        + " loopLatency=" + juce::String(loopLatency));
+
+    reset();
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::release()
+{
+    // Unused engine (e.g. the float one while the host runs double) - give
+    // back the ring buffers; the next prepare() reallocates them
+    for (auto& ring : delayBuffers)
+        std::vector<SampleType>().swap(ring);
+    std::vector<Lanes>().swap(wetScratch);
+    std::vector<Lanes>().swap(feedbackScratch);
+    std::vector<float>().swap(modulationScratch);
+    saturationScratch.setSize(0, 0);
+    oversampler2x.reset();
+    oversampler4x.reset();
+    activeOversampler = nullptr;
+    delayMask = 0;
+    writePos = 0;
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::reset()
+{
+    // Invalidate delay buffers without clearing them (no 2 x capacity memset
+    // on the audio thread) - readDelay() masks everything not yet rewritten
+    primedSamples = 0;
+    resetFadeRemaining = resetFadeLength;
+    crossfadeRemaining = 0;
+
+    // Nothing left to glitch - take up a requested render tier
+    applyRenderQuality();
+
+    // Reset all filter states (prevents ghost tones)
+    for (int group = 0; group < MAX_GROUPS; ++group)
+    {
+        bandpass[static_cast<size_t>(group)].reset();
+        degradeLP[static_cast<size_t>(group)].reset();
+        feedbackLP[static_cast<size_t>(group)].reset();
+    }
+
+    // Reset degradation state
+    hold.fill(Lanes {});
+    holdCounter = 0;
+
+    // Clock back at rest (the depth glides in again)
+    wowFlutter.reset();
+
+    // Reset softclip anti-aliasing state and the dry compensation ring
+    adaaPrevious.fill(SampleType(0));
+    if (activeOversampler != nullptr)
+        activeOversampler->reset();
+    std::fill(dryCompensation.begin(), dryCompensation.end(), Lanes {});
+    dryCompensationPos = 0;
+
+    // Wake up (first blocks after reset always run the full chain)
+    sleeping = false;
+    quietSamples = 0;
+
+    // Sync delay time (avoid smoothing zipper on restart)
+    settleDelay();
+    for (auto& tap : extraTaps)
+        settleTap(tap);
+
+    DBG("DubDelay::reset() - buffers invalidated, filters cleared");
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int channels = std::min(buffer.getNumChannels(), preparedChannels);  // Channels beyond prepare() pass through
+
+    if (channels < 1 || delayBuffers[0].empty()) return;  // Not prepared yet
+
+    // Kernels only maintain the rings of the channels they run (mono: the
+    // left one) - more channels than last time start the others from a
+    // clean (masked) state
+    if (channels > ringChannels)
+        reset();
+    ringChannels = channels;
+    numChannels = channels;
+    numGroups = groupCount(channels);
+
+    SampleType* channelData[MAX_CHANNELS] = {};
+    SampleType* chunkChannels[MAX_CHANNELS] = {};
+    for (int channel = 0; channel < channels; ++channel)
+        channelData[channel] = buffer.getWritePointer(channel);
+
+    // Hosts may exceed the block size announced in prepare(); run in scratch-sized chunks
+    int chunk = 0;
+    for (int start = 0; start < numSamples; start += chunk)
+    {
+        chunk = std::min(maxBlockSize, numSamples - start);
+
+        // An oversampled loop shorter than the block would otherwise run the
+        // oversampler per sample - cut the block into runs the staged engine
+        // can take instead
+        modulationActive = wowFlutter.isActive();
+        if (activeOversampler != nullptr && ! canProcessStaged(chunk))
+        {
+            const int run = getStagedRunLength();
+            if (run > 0)
+                chunk = run;
+        }
+
+        SampleType peak = 0;
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            chunkChannels[channel] = channelData[channel] + start;
+            peak = std::max(peak, juce::FloatVectorOperations::findMaximum(chunkChannels[channel], chunk));
+            peak = std::max(peak, -juce::FloatVectorOperations::findMinimum(chunkChannels[channel], chunk));
+        }
+        const auto inputPeak = static_cast<float>(peak);
+
+        if (sleeping)
+        {
+            if (inputPeak < SLEEP_THRESHOLD)
+            {
+                lastEnginePath = EnginePath::sleeping;
+                processSleeping(chunkChannels, chunk);
+                continue;
+            }
+
+            // Wake instantly - this chunk already runs the full chain
+            sleeping = false;
+            quietSamples = 0;
+        }
+
+        // Wow/flutter deviation for this chunk (skipped entirely at depth 0)
+        if (modulationActive)
+            wowFlutter.process(modulationScratch.data(), chunk);
+
+        // One dispatch per chunk onto the kernel specialised for this configuration
+        const bool staged = canProcessStaged(chunk);
+        lastEnginePath = staged ? EnginePath::staged : EnginePath::perSample;
+        (this->*selectKernel(staged, channels))(chunkChannels, chunk);
+
+        if (resetFadeRemaining > 0)
+            applyResetFade(chunkChannels, chunk);
+
+        updateSleepState(inputPeak, chunk);
+    }
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::updateSleepState(float inputPeak, int numSamples)
+{
+    if (inputPeak >= SLEEP_THRESHOLD || wetPeak >= SLEEP_THRESHOLD)
+    {
+        quietSamples = 0;
+        return;
+    }
+
+    quietSamples = std::min(quietSamples + numSamples, delayMask + 1);
+
+    float longestDelay = std::max(delayTimeSamples, targetDelayTimeSamples);
+    for (int k = 0; k < numActiveTaps; ++k)
+    {
+        const auto& tap = extraTaps[static_cast<size_t>(tapOrder[static_cast<size_t>(k)])];
+        longestDelay = std::max(longestDelay, std::max(tap.delaySamples, tap.targetSamples));
+    }
+
+    if (modulationActive)
+        longestDelay *= 1.0f + WowFlutter::MAX_DEVIATION;
+
+    // Quiet for longer than the delay: every tap the chain can currently
+    // reach holds (near) silence
+    const int margin = renderQuality == RenderQuality::offline ? SINC_MARGIN : INTERPOLATION_MARGIN;
+    if (quietSamples > static_cast<int>(longestDelay) + margin
+        && resetFadeRemaining == 0 && crossfadeRemaining == 0)
+    {
+        sleeping = true;
+
+        // Anything older than the quiet stretch would have been overwritten
+        // with silence had we kept running - mask it like after reset()
+        primedSamples = std::min(primedSamples, quietSamples);
+
+        // Silent loop: a pending render tier can switch now
+        applyRenderQuality();
+
+        // No audible glide while asleep: land on the target now
+        settleDelay();
+        for (auto& tap : extraTaps)
+            settleTap(tap);
+
+        DBG("DubDelay: sleeping");
+    }
+}
+
+template <typename SampleType>
+double DubDelay<SampleType>::getTailLengthSeconds() const
+{
+    // Longest round trip through the ring: the TIME tap or an extra tap, at
+    // the far end of a glide, stretched by the wow/flutter excursion. Every
+    // tap feeds the loop, so their levels add to the loop gain.
+    float longestDelay = std::max(delayTimeSamples, targetDelayTimeSamples);
+    double tapGain = 1.0;
+    for (const auto& tap : extraTaps)
+    {
+        if (! tap.active)
+            continue;
+
+        longestDelay = std::max(longestDelay, std::max(tap.delaySamples, tap.targetSamples));
+        tapGain += tap.level;
+    }
+
+    if (wowFlutter.isActive())
+        longestDelay *= 1.0f + WowFlutter::MAX_DEVIATION;
+
+    // The bandpass adds its group delay at the peak (2Q / w0 per stage) to
+    // every round trip, and rings out for about that long again per neper
+    const int stages = filter24dB ? 2 : 1;
+    const double groupDelay = stages * 2.0 * filterQ / (juce::MathConstants<double>::twoPi * filterFreq);
+    const double roundTrip = static_cast<double>(longestDelay) / currentSampleRate + groupDelay;
+    const double ringing = groupDelay * TAIL_FLOOR_DB / 20.0 * std::log(10.0);
+
+    const double wetGain = static_cast<double>(outputGain) * wetMix;
+    if (wetGain <= 0.0)
+        return 0.0;
+
+    if (feedback <= 0.0f)
+        return roundTrip + ringing;
+
+    // Loop gain per round trip: FEEDBACK x the filters' peak (bandpass and
+    // lowpasses together) x the largest crossfeed row sum x the taps. The
+    // sample-and-hold and the softclip (slope <= 1) only take gain away, and
+    // the ceiling bounds what a round trip starts from - so below 1 the loop
+    // decays from the ceiling in a bounded number of trips, and at or above 1
+    // it self-oscillates (the default patch does: FEEDBACK 50 x Q 2.75).
+    float crossfeed = 1.0f;
+    for (int to = 0; to < preparedChannels; ++to)
+    {
+        float row = 1.0f;
+        for (int from = 0; from < preparedChannels; ++from)
+            row += crossfeedMatrix[static_cast<size_t>(to)][static_cast<size_t>(from)];
+        crossfeed = std::max(crossfeed, row);
+    }
+
+    const double peak = std::pow(static_cast<double>(filterQ), stages);
+    const double loopGain = feedback * getLoopFilterGain() * crossfeed * tapGain;
+    if (loopGain >= 1.0)
+        return std::numeric_limits<double>::infinity();
+
+    // First repeat at worst: a 0 dBFS input on top of a ceiling-level
+    // feedback write, through the bandpass peak, every tap and the output gain
+    const double startDb = juce::Decibels::gainToDecibels((1.0 + FB_WRITE_LIMIT) * peak * tapGain * wetGain, -1000.0);
+    const double decayDbPerTrip = -juce::Decibels::gainToDecibels(loopGain, -1000.0);
+    const double trips = std::ceil(std::max(0.0, startDb + TAIL_FLOOR_DB) / decayDbPerTrip);
+
+    return roundTrip * (1.0 + trips) + ringing;
+}
+
+template <typename SampleType>
+double DubDelay<SampleType>::getLoopFilterGain() const
+{
+    // Every filter is a bilinear (prewarped) analog prototype, so its gain at
+    // f is the prototype's at W = tan(pi f / fs) / tan(pi fc / fs). The
+    // bandpass rises up to FREQ and falls after it, the Butterworth lowpasses
+    // only fall: on a band [f1, f2] below FREQ the product is at most
+    // bandpass(f2) x lowpasses(f1), and above FREQ at most its value at FREQ.
+    // So the bound over a grid below FREQ is never under the true peak.
+    constexpr int steps = 64;
+    constexpr double lowestHz = 10.0;
+
+    const auto warp = [this] (double hz)
+    {
+        return std::tan(juce::MathConstants<double>::pi * std::min(hz, 0.49 * currentSampleRate) / currentSampleRate);
+    };
+
+    const double centre = warp(filterFreq);
+    const double feedbackCutoff = warp(FEEDBACK_LPF_FREQ);
+    const double degradeWarped = warp(degradeCutoff);
+    const bool degradeOn = degradation > DEGRADE_THRESHOLD;
+    const int stages = filter24dB ? 2 : 1;
+
+    const auto bandpassGain = [&] (double w)
+    {
+        const double x = w / centre;
+        return std::pow(x / std::sqrt((1.0 - x * x) * (1.0 - x * x) + x * x / (filterQ * filterQ)), stages);
+    };
+    const auto lowpassGain = [&] (double w)
+    {
+        const auto butterworth = [] (double x) { return 1.0 / std::sqrt(1.0 + x * x * x * x); };
+        return butterworth(w / feedbackCutoff) * (degradeOn ? butterworth(w / degradeWarped) : 1.0);
+    };
+
+    double bound = bandpassGain(centre) * lowpassGain(centre);
+    double previous = 0.0;
+    for (int k = 0; k <= steps; ++k)
+    {
+        const double w = warp(lowestHz * std::pow(filterFreq / lowestHz, static_cast<double>(k) / steps));
+        bound = std::max(bound, bandpassGain(w) * lowpassGain(previous));
+        previous = w;
+    }
+
+    return bound;
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::processSleeping(SampleType* const* channels, int numSamples) const
+{
+    // Wet path is silent - output is just the (sub-threshold) dry signal
+    const auto dryGain = static_cast<SampleType>(1.0f - wetMix);
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::multiply(channels[channel], dryGain, numSamples);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::applyResetFade(SampleType* const* channels, int numSamples)
+{
+    // Linear fade-in over RESET_FADE_MS, continued across blocks if needed
+    const int fadeSamples = std::min(numSamples, resetFadeRemaining);
+    const float step = 1.0f / static_cast<float>(resetFadeLength);
+    float gain = static_cast<float>(resetFadeLength - resetFadeRemaining) * step;
+
+    for (int i = 0; i < fadeSamples; ++i)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[channel][i] *= gain;
+        gain += step;
+    }
+
+    resetFadeRemaining -= fadeSamples;
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::skipResetFade()
+{
+    // The fade covers a jump in a running signal - an offline render that
+    // starts here would only ramp its own first 5 ms of dry
+    resetFadeRemaining = 0;
+}
+
+template <typename SampleType>
+float DubDelay<SampleType>::getShortestReadDelay() const
+{
+    // Smoothing only moves delayTimeSamples towards the target, so the
+    // smaller of the two bounds the whole block. Every active extra tap has
+    // to clear the same bound.
+    float shortestDelay = std::min(delayTimeSamples, targetDelayTimeSamples);
+    for (int k = 0; k < numActiveTaps; ++k)
+    {
+        const auto& tap = extraTaps[static_cast<size_t>(tapOrder[static_cast<size_t>(k)])];
+        shortestDelay = std::min(shortestDelay, std::min(tap.delaySamples, tap.targetSamples));
+    }
+
+    if (crossfadeRemaining > 0)
+        shortestDelay = std::min(shortestDelay, crossfadeFromSamples);
+
+    if (modulationActive)
+        shortestDelay *= 1.0f - WowFlutter::MAX_DEVIATION;
+
+    const int readAhead = renderQuality == RenderQuality::offline ? WindowedSinc<SampleType>::HALF_TAPS : 2;
+    return shortestDelay - static_cast<float>(loopLatency + readAhead);
+}
+
+template <typename SampleType>
+bool DubDelay<SampleType>::canProcessStaged(int numSamples) const
+{
+    // Sample i reads up to (writePos + i - delay + 2) for the cubic taps
+    // (+ HALF_TAPS for the sinc). With delay > numSamples + 2 every tap lands
+    // before writePos, i.e. on data written in an earlier block.
+    return getShortestReadDelay() > static_cast<float>(numSamples);
+}
+
+template <typename SampleType>
+int DubDelay<SampleType>::getStagedRunLength() const
+{
+    // Longest chunk canProcessStaged() accepts (0 if none)
+    return std::max(0, static_cast<int>(std::ceil(getShortestReadDelay())) - 1);
+}
+
+//==============================================================================
+// Per-frame stages. Both engines run the same chain in the same order:
+// degrade -> bandpass -> crossfeed/gain -> softclip -> LPF -> ceiling
+// (softclip runs in place over a run of frames - see saturate())
+
+template <typename SampleType>
+typename DubDelay<SampleType>::Lanes DubDelay<SampleType>::makeFrame(SampleType left, SampleType right) noexcept
+{
+    Lanes frame (SampleType(0));
+    frame.set(0, left);
+    frame.set(1, right);
+    return frame;
+}
+
+template <typename SampleType>
+template <int Channels, typename Read>
+void DubDelay<SampleType>::loadFrames(Lanes* frame, int stride, Read&& read) const
+{
+    // read(channel) for every channel the kernel runs, into its group's lane
+    if constexpr (Channels == 1)
+    {
+        juce::ignoreUnused(stride);
+        frame[0] = Lanes::expand(read(0));
+    }
+    else if constexpr (Channels == 2)
+    {
+        juce::ignoreUnused(stride);
+        frame[0] = makeFrame(read(0), read(1));
+    }
+    else
+    {
+        for (int group = 0, channel = 0; group < numGroups; ++group)
+        {
+            Lanes lanes (SampleType(0));
+            for (int lane = 0; lane < LANES && channel < numChannels; ++lane, ++channel)
+                lanes.set(static_cast<size_t>(lane), read(channel));
+            frame[group * stride] = lanes;
+        }
+    }
+}
+
+template <typename SampleType>
+template <int Channels, typename Read>
+void DubDelay<SampleType>::addFrames(Lanes* frame, int stride, const Lanes* gains, Read&& read) const
+{
+    Lanes loaded[MAX_GROUPS];
+    loadFrames<Channels>(loaded, 1, read);
+
+    for (int group = 0; group < groupsFor<Channels>(); ++group)
+        frame[group * stride] += loaded[group] * gains[group];
+}
+
+template <typename SampleType>
+typename DubDelay<SampleType>::Lanes DubDelay<SampleType>::swapChannels(Lanes x) noexcept
+{
+    // L <-> R as one shuffle: adjacent lanes swap in pairs (lanes 2/3 of a
+    // float register carry nothing in stereo, their crossfeed gains are 0)
+   #if JUCE_USE_SIMD && JUCE_USE_SSE_INTRINSICS
+    if constexpr (std::is_same_v<SampleType, float>)
+        return Lanes::fromNative(_mm_shuffle_ps(x.value, x.value, _MM_SHUFFLE(2, 3, 0, 1)));
+    else
+        return Lanes::fromNative(_mm_shuffle_pd(x.value, x.value, 1));
+   #else
+   #if JUCE_USE_SIMD && JUCE_USE_ARM_NEON
+    if constexpr (std::is_same_v<SampleType, float>)
+        return Lanes::fromNative(vrev64q_f32(x.value));
+    else
+   #endif
+    {
+        // Scalar registers (and JUCE's NEON double, which has no native type)
+        Lanes swapped (x);
+        swapped.set(0, x.get(1));
+        swapped.set(1, x.get(0));
+        return swapped;
+    }
+   #endif
+}
+
+template <typename SampleType>
+template <int Channels>
+void DubDelay<SampleType>::degradeFrame(Lanes* frame, int stride) noexcept
+{
+    // Sample-and-hold for "digital" degradation, one clock for every group
+    const bool sampleNow = ++holdCounter >= holdPeriod;
+    if (sampleNow)
+        holdCounter = 0;
+
+    for (int group = 0; group < groupsFor<Channels>(); ++group)
+    {
+        const Lanes x = frame[group * stride];
+        auto& held = hold[static_cast<size_t>(group)];
+        if (sampleNow)
+            held = x;
+
+        // Mix between clean and degraded based on degradation amount, then
+        // lowpass for bandwidth reduction
+        frame[group * stride] = degradeLP[static_cast<size_t>(group)].processSample(x * (1.0f - degradation) + held * degradation);
+    }
+}
+
+template <typename SampleType>
+template <int Channels>
+void DubDelay<SampleType>::feedbackGainFrame(const Lanes* filtered, int filteredStride, Lanes* out, int outStride) const noexcept
+{
+    // Crossfeed, then GAIN.
+    // Stereo is the 2x2 matrix as a lane swap (L += R * panRL, R += L * panLR).
+    // Mono: every lane carries the one channel, so R is L and no swap is needed.
+    if constexpr (Channels == 1)
+    {
+        juce::ignoreUnused(filteredStride, outStride);
+        out[0] = (filtered[0] + filtered[0] * crossfeedGains) * feedback;
+    }
+    else if constexpr (Channels == 2)
+    {
+        juce::ignoreUnused(filteredStride, outStride);
+        out[0] = (filtered[0] + swapChannels(filtered[0]) * crossfeedGains) * feedback;
+    }
+    else
+    {
+        // Matrix-vector product by columns: each source channel, broadcast,
+        // times its column accumulates into every destination group
+        Lanes sum[MAX_GROUPS];
+        for (int group = 0; group < numGroups; ++group)
+            sum[group] = Lanes (SampleType(0));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const Lanes source = Lanes::expand(filtered[(channel / LANES) * filteredStride].get(static_cast<size_t>(channel % LANES)));
+            const auto& column = crossfeedColumns[static_cast<size_t>(channel)];
+
+            for (int group = 0; group < numGroups; ++group)
+                sum[group] = Lanes::multiplyAdd(sum[group], column[static_cast<size_t>(group)], source);
+        }
+
+        for (int group = 0; group < numGroups; ++group)
+            out[group * outStride] = sum[group] * feedback;
+    }
+}
+
+template <typename SampleType>
+typename DubDelay<SampleType>::Lanes DubDelay<SampleType>::feedbackCeiling(Lanes x) const noexcept
+{
+    // CEILING (invariant - see domain.md, GitHub #5)
+    // Clamp feedback only, not dry input - preserves transients
+    return Lanes::min(Lanes::max(x, Lanes::expand(-FB_WRITE_LIMIT)), Lanes::expand(FB_WRITE_LIMIT));
+}
+
+//==============================================================================
+// Kernels, specialised at compile time on <Channels, Filter24dB, DegradeOn,
+// HighQuality>. The per-block checks (channel layout, 12/24 dB, degradation
+// on/off, render tier) become template arguments, so each loop below is
+// branch-free and fully inlined.
+// Mono kernels touch only the left ring and carry the one channel in every
+// lane (so the crossfeed term is L * panRL, as before with R = L).
+// Multichannel kernels loop over the channel groups; for mono and stereo
+// the group loops are a single, compile-time iteration.
+
+template <typename SampleType>
+typename DubDelay<SampleType>::Kernel DubDelay<SampleType>::selectKernel(bool staged, int channels) const
+{
+    // [highQuality][mono/stereo/multichannel][filter24dB][degradeOn]
+    static constexpr Kernel stagedKernels[2][3][2][2] =
+    {
+        { { { &DubDelay::processStaged<1, false, false, false>, &DubDelay::processStaged<1, false, true, false> },
+            { &DubDelay::processStaged<1, true,  false, false>, &DubDelay::processStaged<1, true,  true, false> } },
+          { { &DubDelay::processStaged<2, false, false, false>, &DubDelay::processStaged<2, false, true, false> },
+            { &DubDelay::processStaged<2, true,  false, false>, &DubDelay::processStaged<2, true,  true, false> } },
+          { { &DubDelay::processStaged<MULTICHANNEL, false, false, false>, &DubDelay::processStaged<MULTICHANNEL, false, true, false> },
+            { &DubDelay::processStaged<MULTICHANNEL, true,  false, false>, &DubDelay::processStaged<MULTICHANNEL, true,  true, false> } } },
+        { { { &DubDelay::processStaged<1, false, false, true>,  &DubDelay::processStaged<1, false, true, true> },
+            { &DubDelay::processStaged<1, true,  false, true>,  &DubDelay::processStaged<1, true,  true, true> } },
+          { { &DubDelay::processStaged<2, false, false, true>,  &DubDelay::processStaged<2, false, true, true> },
+            { &DubDelay::processStaged<2, true,  false, true>,  &DubDelay::processStaged<2, true,  true, true> } },
+          { { &DubDelay::processStaged<MULTICHANNEL, false, false, true>,  &DubDelay::processStaged<MULTICHANNEL, false, true, true> },
+            { &DubDelay::processStaged<MULTICHANNEL, true,  false, true>,  &DubDelay::processStaged<MULTICHANNEL, true,  true, true> } } }
+    };
+
+    static constexpr Kernel perSampleKernels[2][3][2][2] =
+    {
+        { { { &DubDelay::processPerSample<1, false, false, false>, &DubDelay::processPerSample<1, false, true, false> },
+            { &DubDelay::processPerSample<1, true,  false, false>, &DubDelay::processPerSample<1, true,  true, false> } },
+          { { &DubDelay::processPerSample<2, false, false, false>, &DubDelay::processPerSample<2, false, true, false> },
+            { &DubDelay::processPerSample<2, true,  false, false>, &DubDelay::processPerSample<2, true,  true, false> } },
+          { { &DubDelay::processPerSample<MULTICHANNEL, false, false, false>, &DubDelay::processPerSample<MULTICHANNEL, false, true, false> },
+            { &DubDelay::processPerSample<MULTICHANNEL, true,  false, false>, &DubDelay::processPerSample<MULTICHANNEL, true,  true, false> } } },
+        { { { &DubDelay::processPerSample<1, false, false, true>,  &DubDelay::processPerSample<1, false, true, true> },
+            { &DubDelay::processPerSample<1, true,  false, true>,  &DubDelay::processPerSample<1, true,  true, true> } },
+          { { &DubDelay::processPerSample<2, false, false, true>,  &DubDelay::processPerSample<2, false, true, true> },
+            { &DubDelay::processPerSample<2, true,  false, true>,  &DubDelay::processPerSample<2, true,  true, true> } },
+          { { &DubDelay::processPerSample<MULTICHANNEL, false, false, true>,  &DubDelay::processPerSample<MULTICHANNEL, false, true, true> },
+            { &DubDelay::processPerSample<MULTICHANNEL, true,  false, true>,  &DubDelay::processPerSample<MULTICHANNEL, true,  true, true> } } }
+    };
+
+    const bool degradeOn = degradation > DEGRADE_THRESHOLD;
+    const bool highQuality = renderQuality == RenderQuality::offline;
+    const int layout = std::min(channels, 3) - 1;
+    return (staged ? stagedKernels : perSampleKernels)[highQuality ? 1 : 0][layout][filter24dB ? 1 : 0][degradeOn ? 1 : 0];
+}
+
+template <typename SampleType>
+template <int Channels>
+typename DubDelay<SampleType>::Lanes DubDelay<SampleType>::loadFrame(SampleType left, SampleType right) noexcept
+{
+    if constexpr (Channels == 1)
+    {
+        juce::ignoreUnused(right);
+        return Lanes::expand(left);
+    }
+    else
+    {
+        return makeFrame(left, right);
+    }
+}
+
+template <typename SampleType>
+template <int Channels>
+float DubDelay<SampleType>::framePeak(const Lanes* peak) const noexcept
+{
+    if constexpr (Channels == 1)
+        return static_cast<float>(peak[0].get(0));
+    else if constexpr (Channels == 2)
+        return static_cast<float>(std::max(peak[0].get(0), peak[0].get(1)));
+    else
+    {
+        SampleType highest = 0;
+        for (int channel = 0; channel < numChannels; ++channel)
+            highest = std::max(highest, peak[channel / LANES].get(static_cast<size_t>(channel % LANES)));
+        return static_cast<float>(highest);
+    }
+}
+
+template <typename SampleType>
+template <int Channels, bool Filter24dB, bool DegradeOn, bool HighQuality>
+void DubDelay<SampleType>::processStaged(SampleType* const* channels, int numSamples)
+{
+    Lanes* wet = wetScratch.data();
+    Lanes* fb = feedbackScratch.data();
+    const int groups = groupsFor<Channels>();
+    const int stride = maxBlockSize;  // Group g's frames start at g * stride
+
+    // READ (smoothed delay time, cubic or windowed-sinc interpolation)
+    if (modulationActive)
+    {
+        // Wow/flutter: the clock deviation stretches the smoothed delay
+        const float* deviation = modulationScratch.data();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            delaySmoothingOffset *= DELAY_SMOOTHING;
+            delayTimeSamples = targetDelayTimeSamples + delaySmoothingOffset;
+            const int validSamples = primedSamples + i;
+            const float readTime = readDelayTime(delayTimeSamples * (1.0f + deviation[i]));
+            loadFrames<Channels>(wet + i, stride, [&] (int channel)
+            {
+                return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos + i, readTime, validSamples);
+            });
+        }
+
+        if (! delaySettled)
+            updateDelaySettling();
+    }
+    else if (delaySettled)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int validSamples = primedSamples + i;
+            loadFrames<Channels>(wet + i, stride, [&] (int channel)
+            {
+                return readSettled<HighQuality>(delayBuffers[static_cast<size_t>(channel)], settledTap, writePos + i, validSamples);
+            });
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            delaySmoothingOffset *= DELAY_SMOOTHING;
+            delayTimeSamples = targetDelayTimeSamples + delaySmoothingOffset;
+            const int validSamples = primedSamples + i;
+            const float readTime = readDelayTime(delayTimeSamples);
+            loadFrames<Channels>(wet + i, stride, [&] (int channel)
+            {
+                return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos + i, readTime, validSamples);
+            });
+        }
+
+        updateDelaySettling();
+    }
+
+    // Program change: blend out of the previous delay time
+    if (crossfadeRemaining > 0)
+        crossfadeRead<Channels, HighQuality>(wet, numSamples);
+
+    // Extra taps, summed onto the TIME tap
+    if (numActiveTaps > 0)
+        readExtraTaps<Channels, HighQuality>(wet, numSamples);
+
+    // DEGRADE (sample-and-hold mix, then bandwidth lowpass)
+    if constexpr (DegradeOn)
+        for (int i = 0; i < numSamples; ++i) degradeFrame<Channels>(wet + i, stride);
+
+    // BANDPASS (one pass per filter stage and channel group)
+    for (int group = 0; group < groups; ++group)
+        bandpass[static_cast<size_t>(group)].template process<Filter24dB>(wet + group * stride, numSamples);
+
+    // CROSSFEED + GAIN -> SOFTCLIP -> LPF -> CEILING (see domain.md)
+    for (int i = 0; i < numSamples; ++i) feedbackGainFrame<Channels>(wet + i, stride, fb + i, stride);
+    saturate(fb, numSamples, stride, saturationChannels<Channels>());
+
+    Lanes peak[MAX_GROUPS];
+    for (int group = 0; group < groups; ++group)
+    {
+        Lanes* groupWet = wet + group * stride;
+        Lanes* groupFb = fb + group * stride;
+        auto& lowpass = feedbackLP[static_cast<size_t>(group)];
+
+        for (int i = 0; i < numSamples; ++i) groupFb[i] = lowpass.processSample(groupFb[i]);
+        for (int i = 0; i < numSamples; ++i) groupFb[i] = feedbackCeiling(groupFb[i]);
+
+        // Wet-path peak for sleep detection
+        peak[group] = Lanes (SampleType(0));
+        for (int i = 0; i < numSamples; ++i)
+            peak[group] = Lanes::max(peak[group], Lanes::max(Lanes::abs(groupWet[i]), Lanes::abs(groupFb[i])));
+    }
+    wetPeak = framePeak<Channels>(peak);
+
+    // WRITE (input + feedback) and MIX dry/wet with output gain
+    const auto dryGain = static_cast<SampleType>(1.0f - wetMix);
+    const auto wetGain = static_cast<SampleType>(outputGain * wetMix);
+
+    if constexpr (Channels == MULTICHANNEL)
+    {
+        if (loopLatency > 0)
+        {
+            // Hold the dry feed back by the softclip latency (fb is already late by that much)
+            for (int i = 0; i < numSamples; ++i)
+            {
+                Lanes dry[MAX_GROUPS];
+                loadFrames<Channels>(dry, 1, [&] (int channel) { return channels[channel][i]; });
+                compensateDry(dry, groups);
+                for (int group = 0; group < groups; ++group)
+                    fb[group * stride + i] += dry[group];
+            }
+        }
+
+        // Channel by channel: each ring and host buffer is one contiguous run
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            SampleType* ring = delayBuffers[static_cast<size_t>(channel)].data();
+            SampleType* io = channels[channel];
+            const Lanes* channelFb = fb + (channel / LANES) * stride;
+            const Lanes* channelWet = wet + (channel / LANES) * stride;
+            const auto lane = static_cast<size_t>(channel % LANES);
+            int wp = writePos;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                ring[wp] = loopLatency > 0 ? channelFb[i].get(lane) : io[i] + channelFb[i].get(lane);
+                wp = (wp + 1) & delayMask;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                io[i] = io[i] * dryGain + channelWet[i].get(lane) * wetGain;
+        }
+
+        writePos = (writePos + numSamples) & delayMask;
+    }
+    else
+    {
+        SampleType* leftChannel = channels[0];
+        SampleType* rightChannel = Channels == 2 ? channels[1] : nullptr;
+        auto& delayBufferL = delayBuffers[0];
+        auto& delayBufferR = delayBuffers[1];
+        int wp = writePos;
+
+        if (loopLatency > 0)
+        {
+            // Hold the dry feed back by the softclip latency (fb is already late by that much)
+            for (int i = 0; i < numSamples; ++i)
+            {
+                Lanes dry = loadFrame<Channels>(leftChannel[i], Channels == 2 ? rightChannel[i] : SampleType(0));
+                compensateDry(&dry, 1);
+                fb[i] += dry;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                delayBufferL[static_cast<size_t>(wp)] = fb[i].get(0);
+                if constexpr (Channels == 2)
+                    delayBufferR[static_cast<size_t>(wp)] = fb[i].get(1);
+                wp = (wp + 1) & delayMask;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                delayBufferL[static_cast<size_t>(wp)] = leftChannel[i] + fb[i].get(0);
+                if constexpr (Channels == 2)
+                    delayBufferR[static_cast<size_t>(wp)] = rightChannel[i] + fb[i].get(1);
+                wp = (wp + 1) & delayMask;
+            }
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            leftChannel[i] = leftChannel[i] * dryGain + wet[i].get(0) * wetGain;
+            if constexpr (Channels == 2)
+                rightChannel[i] = rightChannel[i] * dryGain + wet[i].get(1) * wetGain;
+        }
+
+        juce::ignoreUnused(rightChannel, delayBufferR);
+        writePos = wp;
+    }
+
+    primedSamples = std::min(primedSamples + numSamples, delayMask + 1);
+}
+
+template <typename SampleType>
+template <int Channels, bool Filter24dB, bool DegradeOn, bool HighQuality>
+void DubDelay<SampleType>::processPerSample(SampleType* const* channels, int numSamples)
+{
+    const bool settled = delaySettled && ! modulationActive;
+    const float* deviation = modulationActive ? modulationScratch.data() : nullptr;
+    const auto dryGain = static_cast<SampleType>(1.0f - wetMix);
+    const int groups = groupsFor<Channels>();
+
+    Lanes peak[MAX_GROUPS];
+    for (int group = 0; group < groups; ++group)
+        peak[group] = Lanes (SampleType(0));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float clock = deviation != nullptr ? 1.0f + deviation[i] : 1.0f;
+
+        // Read from delay lines (fixed tap once settled, else smoothed + interpolated)
+        Lanes delayed[MAX_GROUPS];
+
+        if (settled)
+        {
+            loadFrames<Channels>(delayed, 1, [&] (int channel)
+            {
+                return readSettled<HighQuality>(delayBuffers[static_cast<size_t>(channel)], settledTap, writePos, primedSamples);
+            });
+        }
+        else
+        {
+            // Smooth delay time changes (stretched by wow/flutter when active)
+            delaySmoothingOffset *= DELAY_SMOOTHING;
+            delayTimeSamples = targetDelayTimeSamples + delaySmoothingOffset;
+            const float readTime = readDelayTime(deviation != nullptr ? delayTimeSamples * clock : delayTimeSamples);
+            loadFrames<Channels>(delayed, 1, [&] (int channel)
+            {
+                return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos, readTime, primedSamples);
+            });
+        }
+
+        if (crossfadeRemaining > 0)
+            crossfadeReadSample<Channels, HighQuality>(delayed, clock);
+
+        if (numActiveTaps > 0)
+            readExtraTapsSample<Channels, HighQuality>(delayed, clock);
+
+        // Apply degradation (sample rate reduction + lowpass)
+        if constexpr (DegradeOn)
+            degradeFrame<Channels>(delayed, 1);
+
+        // Apply bandpass filter in feedback path
+        Lanes filtered[MAX_GROUPS];
+        for (int group = 0; group < groups; ++group)
+            filtered[group] = bandpass[static_cast<size_t>(group)].template processSample<Filter24dB>(delayed[group]);
+
+        // Crossfeed + GAIN, SOFTCLIP (musical saturation - generates HF harmonics)
+        Lanes feedbackFrame[MAX_GROUPS];
+        feedbackGainFrame<Channels>(filtered, 1, feedbackFrame, 1);
+        saturate(feedbackFrame, 1, 1, saturationChannels<Channels>());
+
+        // LPF (after softclip! removes edge harmonics before re-injection)
+        // See: GitHub issue #4, domain.md
+        for (int group = 0; group < groups; ++group)
+        {
+            feedbackFrame[group] = feedbackCeiling(feedbackLP[static_cast<size_t>(group)].processSample(feedbackFrame[group]));
+            peak[group] = Lanes::max(peak[group], Lanes::max(Lanes::abs(filtered[group]), Lanes::abs(feedbackFrame[group])));
+        }
+
+        if constexpr (Channels == MULTICHANNEL)
+        {
+            // Write to delay buffers (input + feedback)
+            Lanes dryFrame[MAX_GROUPS];
+            loadFrames<Channels>(dryFrame, 1, [&] (int channel) { return channels[channel][i]; });
+            if (loopLatency > 0)
+                compensateDry(dryFrame, groups);
+
+            Lanes written[MAX_GROUPS];
+            for (int group = 0; group < groups; ++group)
+                written[group] = feedbackFrame[group] + dryFrame[group];
 
-    // Degradation lowpass
-    degradeLPL.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    degradeLPR.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const int group = channel / LANES;
+                const auto lane = static_cast<size_t>(channel % LANES);
+                const SampleType dry = channels[channel][i];
+
+                delayBuffers[static_cast<size_t>(channel)][static_cast<size_t>(writePos)] = written[group].get(lane);
+
+                // Mix dry/wet and apply output gain
+                channels[channel][i] = dry * dryGain + filtered[group].get(lane) * outputGain * wetMix;
+            }
+        }
+        else
+        {
+            SampleType* leftChannel = channels[0];
+            SampleType* rightChannel = Channels == 2 ? channels[1] : nullptr;
+
+            // Get dry input
+            const SampleType dryL = leftChannel[i];
+            const SampleType dryR = Channels == 2 ? rightChannel[i] : dryL;
+
+            // Write to delay buffer (input + feedback)
+            Lanes dryFrame = loadFrame<Channels>(dryL, dryR);
+            if (loopLatency > 0)
+                compensateDry(&dryFrame, 1);
+            const Lanes written = feedbackFrame[0] + dryFrame;
+            delayBuffers[0][static_cast<size_t>(writePos)] = written.get(0);
+            if constexpr (Channels == 2)
+                delayBuffers[1][static_cast<size_t>(writePos)] = written.get(1);
 
-    // Feedback-path LPF (darkens repeats - issue #4)
-    feedbackLPL.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    feedbackLPR.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    feedbackLPL.setCutoffFrequency(FEEDBACK_LPF_FREQ);
-    feedbackLPR.setCutoffFrequency(FEEDBACK_LPF_FREQ);
+            // Mix dry/wet and apply output gain
+            leftChannel[i] = dryL * dryGain + filtered[0].get(0) * outputGain * wetMix;
+            if constexpr (Channels == 2)
+                rightChannel[i] = dryR * dryGain + filtered[0].get(1) * outputGain * wetMix;
+        }
+
+        writePos = (writePos + 1) & delayMask;
+        primedSamples = std::min(primedSamples + 1, delayMask + 1);
+    }
+
+    wetPeak = framePeak<Channels>(peak);
+
+    if (! delaySettled)
+        updateDelaySettling();
+
+    if (numActiveTaps > 0)
+        updateTapSettling();
 }
 
-void DubDelay::prepare(double sampleRate, int /*samplesPerBlock*/)
+template <typename SampleType>
+void DubDelay<SampleType>::crossfadeDelayTime()
 {
-    currentSampleRate = sampleRate;
+    const float jump = std::abs(delayTimeSamples - targetDelayTimeSamples);
+    if (jump < CROSSFADE_MIN_JUMP_MS * static_cast<float>(currentSampleRate) / 1000.0f)
+        return;
+
+    // Asleep the ring is silent - nothing to blend
+    if (! sleeping)
+    {
+        crossfadeFromSamples = delayTimeSamples;
+        crossfadeRemaining = crossfadeLength;
+    }
 
-    // Prepare filters
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = 512;
-    spec.numChannels = 1;
-
-    filterL1.prepare(spec);
-    filterR1.prepare(spec);
-    filterL2.prepare(spec);
-    filterR2.prepare(spec);
-    degradeLPL.prepare(spec);
-    degradeLPR.prepare(spec);
-    feedbackLPL.prepare(spec);
-    feedbackLPR.prepare(spec);
+    settleDelay();
+}
 
-    // Log DSP config (once per init - see domain.md)
-    DBG("DubDelay::prepare() - sampleRate=" + juce::String(sampleRate)
-        + " FB_WRITE_LIMIT=" + juce::String(FB_WRITE_LIMIT)
-        + " FEEDBACK_LPF_FREQ=" + juce::String(FEEDBACK_LPF_FREQ));
+template <typename SampleType>
+template <int Channels, bool HighQuality>
+void DubDelay<SampleType>::crossfadeRead(Lanes* wet, int numSamples)
+{
+    // Linear blend from the outgoing position, continued across blocks if needed
+    const int fadeSamples = std::min(numSamples, crossfadeRemaining);
+    const float step = 1.0f / static_cast<float>(crossfadeLength);
+    float gain = static_cast<float>(crossfadeLength - crossfadeRemaining) * step;
+    const float* deviation = modulationActive ? modulationScratch.data() : nullptr;
 
-    reset();
+    for (int i = 0; i < fadeSamples; ++i)
+    {
+        const int validSamples = primedSamples + i;
+        const float readTime = readDelayTime(deviation != nullptr ? crossfadeFromSamples * (1.0f + deviation[i])
+                                                                  : crossfadeFromSamples);
+        Lanes outgoing[MAX_GROUPS];
+        loadFrames<Channels>(outgoing, 1, [&] (int channel)
+        {
+            return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos + i, readTime, validSamples);
+        });
+
+        for (int group = 0; group < groupsFor<Channels>(); ++group)
+        {
+            Lanes& frame = wet[group * maxBlockSize + i];
+            frame = outgoing[group] + (frame - outgoing[group]) * static_cast<SampleType>(gain);
+        }
+
+        gain += step;
+    }
+
+    crossfadeRemaining -= fadeSamples;
 }
 
-void DubDelay::reset()
+template <typename SampleType>
+template <int Channels, bool HighQuality>
+void DubDelay<SampleType>::crossfadeReadSample(Lanes* delayed, float clock)
 {
-    // Clear delay buffers
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
-    writePos = 0;
+    const float gain = static_cast<float>(crossfadeLength - crossfadeRemaining) / static_cast<float>(crossfadeLength);
+    const float readTime = readDelayTime(crossfadeFromSamples * clock);
+    Lanes outgoing[MAX_GROUPS];
+    loadFrames<Channels>(outgoing, 1, [&] (int channel)
+    {
+        return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos, readTime, primedSamples);
+    });
 
-    // Reset all filter states (prevents ghost tones)
-    filterL1.reset();
-    filterR1.reset();
-    filterL2.reset();
-    filterR2.reset();
-    degradeLPL.reset();
-    degradeLPR.reset();
-    feedbackLPL.reset();
-    feedbackLPR.reset();
+    --crossfadeRemaining;
+    for (int group = 0; group < groupsFor<Channels>(); ++group)
+        delayed[group] = outgoing[group] + (delayed[group] - outgoing[group]) * static_cast<SampleType>(gain);
+}
 
-    // Reset degradation state
-    holdL = holdR = 0.0f;
-    holdCounter = 0;
+template <typename SampleType>
+void DubDelay<SampleType>::updateDelaySettling()
+{
+    if (std::abs(delaySmoothingOffset) < SETTLE_THRESHOLD)
+        settleDelay();
+}
 
-    // Sync delay time (avoid smoothing zipper on restart)
+template <typename SampleType>
+void DubDelay<SampleType>::settleDelay()
+{
+    // Snap onto the target and precompute the constant read tap
     delayTimeSamples = targetDelayTimeSamples;
+    delaySmoothingOffset = 0.0f;
+    settledTap = makeFixedTap(readDelayTime(delayTimeSamples));
+    delaySettled = true;
+}
+
+template <typename SampleType>
+typename DubDelay<SampleType>::FixedTap DubDelay<SampleType>::makeFixedTap(float readTime) const
+{
+    FixedTap tap;
+    const int wholeDelay = static_cast<int>(readTime);
+    const float fraction = readTime - static_cast<float>(wholeDelay);
+    const SampleType t = SampleType(1) - fraction;  // Same convention as readDelay()
+
+    tap.readTime = readTime;
+    tap.wholeDelay = wholeDelay;
+    tap.isInteger = fraction == 0.0f;
+
+    // Catmull-Rom as weights on y[-1], y[0], y[1], y[2]
+    tap.w0 = ((-0.5f * t + 1.0f) * t - 0.5f) * t;
+    tap.w1 = (1.5f * t - 2.5f) * t * t + 1.0f;
+    tap.w2 = ((-1.5f * t + 2.0f) * t + 0.5f) * t;
+    tap.w3 = (0.5f * t - 0.5f) * t * t;
+
+    if (renderQuality == RenderQuality::offline)
+        WindowedSinc<SampleType>::weights(t, tap.sinc);
 
-    DBG("DubDelay::reset() - buffers and filters cleared");
+    return tap;
 }
 
-void DubDelay::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+template <bool HighQuality>
+SampleType DubDelay<SampleType>::readSettled(const std::vector<SampleType>& buffer, const FixedTap& tap, int writeIndex, int validSamples) const
 {
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    const int wholeDelay = tap.wholeDelay;
 
-    if (numChannels < 1) return;
+    if constexpr (HighQuality)
+        if (! tap.isInteger && canReadSinc(wholeDelay, validSamples))
+            return WindowedSinc<SampleType>::read(buffer.data(), writeIndex - wholeDelay - WindowedSinc<SampleType>::HALF_TAPS,
+                                                  delayMask, tap.sinc);
 
-    float* leftChannel = buffer.getWritePointer(0);
-    float* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    // Taps that may still be masked after reset() take the general path
+    if (wholeDelay + 2 > validSamples)
+        return readDelay<HighQuality>(buffer, writeIndex, tap.readTime, validSamples);
 
-    // Smoothly interpolate delay time
-    const float smoothingCoeff = 0.9995f;
+    // Integer delay: plain indexed read
+    if (tap.isInteger)
+        return buffer[static_cast<size_t>((writeIndex - wholeDelay) & delayMask)];
 
-    for (int i = 0; i < numSamples; ++i)
+    const int pos0 = (writeIndex - wholeDelay - 1) & delayMask;
+
+    return tap.w0 * buffer[static_cast<size_t>((pos0 - 1) & delayMask)]
+         + tap.w1 * buffer[static_cast<size_t>(pos0)]
+         + tap.w2 * buffer[static_cast<size_t>((pos0 + 1) & delayMask)]
+         + tap.w3 * buffer[static_cast<size_t>((pos0 + 2) & delayMask)];
+}
+
+//==============================================================================
+// Extra taps
+
+template <typename SampleType>
+template <int Channels, bool HighQuality>
+void DubDelay<SampleType>::readExtraTaps(Lanes* wet, int numSamples)
+{
+    // Tap-major: each tap is one pass over a contiguous stretch of the ring,
+    // in delay order. Taps closer together than a block read overlapping
+    // stretches, so later passes find their cache lines already loaded.
+    const int stride = maxBlockSize;
+
+    for (int k = 0; k < numActiveTaps; ++k)
     {
-        // Smooth delay time changes
-        delayTimeSamples = delayTimeSamples * smoothingCoeff + targetDelayTimeSamples * (1.0f - smoothingCoeff);
+        ExtraTap& tap = extraTaps[static_cast<size_t>(tapOrder[static_cast<size_t>(k)])];
+        const Lanes* gains = Channels == 1 ? &tap.levelGains : tap.gains.data();  // Mono ignores pan
 
-        // Read from delay lines with interpolation
-        float delayedL = readDelay(delayBufferL, delayTimeSamples);
-        float delayedR = rightChannel ? readDelay(delayBufferR, delayTimeSamples) : delayedL;
+        if (modulationActive)
+        {
+            const float* deviation = modulationScratch.data();
 
-        // Apply degradation (sample rate reduction + lowpass)
-        if (degradation > 0.001f)
+            for (int i = 0; i < numSamples; ++i)
+            {
+                tap.smoothingOffset *= DELAY_SMOOTHING;
+                tap.delaySamples = tap.targetSamples + tap.smoothingOffset;
+                const int validSamples = primedSamples + i;
+                const float readTime = readDelayTime(tap.delaySamples * (1.0f + deviation[i]));
+                addFrames<Channels>(wet + i, stride, gains, [&] (int channel)
+                {
+                    return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos + i, readTime, validSamples);
+                });
+            }
+        }
+        else if (tap.settled)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const int validSamples = primedSamples + i;
+                addFrames<Channels>(wet + i, stride, gains, [&] (int channel)
+                {
+                    return readSettled<HighQuality>(delayBuffers[static_cast<size_t>(channel)], tap.fixed, writePos + i, validSamples);
+                });
+            }
+        }
+        else
         {
-            // Sample-and-hold for "digital" degradation
-            holdCounter++;
-            if (holdCounter >= holdPeriod)
+            for (int i = 0; i < numSamples; ++i)
             {
-                holdL = delayedL;
-                holdR = delayedR;
-                holdCounter = 0;
+                tap.smoothingOffset *= DELAY_SMOOTHING;
+                tap.delaySamples = tap.targetSamples + tap.smoothingOffset;
+                const int validSamples = primedSamples + i;
+                const float readTime = readDelayTime(tap.delaySamples);
+                addFrames<Channels>(wet + i, stride, gains, [&] (int channel)
+                {
+                    return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos + i, readTime, validSamples);
+                });
             }
+        }
+    }
+
+    updateTapSettling();
+}
+
+template <typename SampleType>
+template <int Channels, bool HighQuality>
+void DubDelay<SampleType>::readExtraTapsSample(Lanes* delayed, float clock)
+{
+    // Taps summed on their own, then onto the TIME tap
+    Lanes sum[MAX_GROUPS];
+    for (int group = 0; group < groupsFor<Channels>(); ++group)
+        sum[group] = Lanes (SampleType(0));
 
-            // Mix between clean and degraded based on degradation amount
-            float degradeMix = degradation;
-            delayedL = delayedL * (1.0f - degradeMix) + holdL * degradeMix;
-            delayedR = delayedR * (1.0f - degradeMix) + holdR * degradeMix;
+    for (int k = 0; k < numActiveTaps; ++k)
+    {
+        ExtraTap& tap = extraTaps[static_cast<size_t>(tapOrder[static_cast<size_t>(k)])];
+        const Lanes* gains = Channels == 1 ? &tap.levelGains : tap.gains.data();
 
-            // Lowpass filter for bandwidth reduction
-            delayedL = degradeLPL.processSample(0, delayedL);
-            delayedR = degradeLPR.processSample(0, delayedR);
+        if (tap.settled && ! modulationActive)
+        {
+            addFrames<Channels>(sum, 1, gains, [&] (int channel)
+            {
+                return readSettled<HighQuality>(delayBuffers[static_cast<size_t>(channel)], tap.fixed, writePos, primedSamples);
+            });
+        }
+        else
+        {
+            tap.smoothingOffset *= DELAY_SMOOTHING;
+            tap.delaySamples = tap.targetSamples + tap.smoothingOffset;
+            const float readTime = readDelayTime(modulationActive ? tap.delaySamples * clock : tap.delaySamples);
+            addFrames<Channels>(sum, 1, gains, [&] (int channel)
+            {
+                return readDelay<HighQuality>(delayBuffers[static_cast<size_t>(channel)], writePos, readTime, primedSamples);
+            });
         }
+    }
 
-        // Apply bandpass filter in feedback path
-        float filteredL = filterL1.processSample(0, delayedL);
-        float filteredR = filterR1.processSample(0, delayedR);
+    for (int group = 0; group < groupsFor<Channels>(); ++group)
+        delayed[group] += sum[group];
+}
 
-        if (filter24dB)
+template <typename SampleType>
+void DubDelay<SampleType>::updateTapSettling()
+{
+    // Checked once per block, like updateDelaySettling()
+    for (int k = 0; k < numActiveTaps; ++k)
+    {
+        ExtraTap& tap = extraTaps[static_cast<size_t>(tapOrder[static_cast<size_t>(k)])];
+        if (! tap.settled && std::abs(tap.smoothingOffset) < SETTLE_THRESHOLD)
+            settleTap(tap);
+    }
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::settleTap(ExtraTap& tap)
+{
+    tap.delaySamples = tap.targetSamples;
+    tap.smoothingOffset = 0.0f;
+    tap.fixed = makeFixedTap(readDelayTime(tap.delaySamples));
+    tap.settled = true;
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::updateTapOrder()
+{
+    // Active taps by ascending delay (insertion sort, at most MAX_TAPS - 1)
+    numActiveTaps = 0;
+
+    for (int index = 0; index < MAX_TAPS - 1; ++index)
+    {
+        if (! extraTaps[static_cast<size_t>(index)].active)
+            continue;
+
+        const float delay = extraTaps[static_cast<size_t>(index)].targetSamples;
+        int k = numActiveTaps++;
+
+        while (k > 0 && extraTaps[static_cast<size_t>(tapOrder[static_cast<size_t>(k - 1)])].targetSamples > delay)
         {
-            filteredL = filterL2.processSample(0, filteredL);
-            filteredR = filterR2.processSample(0, filteredR);
+            tapOrder[static_cast<size_t>(k)] = tapOrder[static_cast<size_t>(k - 1)];
+            --k;
         }
 
-        // Ping-pong crossfeed
-        float crossL = filteredR * panRL;
-        float crossR = filteredL * panLR;
+        tapOrder[static_cast<size_t>(k)] = index;
+    }
+}
 
-        // GAIN
-        float feedbackL = (filteredL + crossL) * feedback;
-        float feedbackR = (filteredR + crossR) * feedback;
+template <typename SampleType>
+void DubDelay<SampleType>::setTap(int tapIndex, float noteValue, float level, float pan)
+{
+    jassert(tapIndex >= 1 && tapIndex < MAX_TAPS);
+    if (tapIndex < 1 || tapIndex >= MAX_TAPS)
+        return;
 
-        // SOFTCLIP (musical saturation - generates HF harmonics)
-        feedbackL = softClip(feedbackL);
-        feedbackR = softClip(feedbackR);
+    ExtraTap& tap = extraTaps[static_cast<size_t>(tapIndex - 1)];
 
-        // LPF (after softclip! removes edge harmonics before re-injection)
-        // See: GitHub issue #4, domain.md
-        feedbackL = feedbackLPL.processSample(0, feedbackL);
-        feedbackR = feedbackLPR.processSample(0, feedbackR);
+    // LEVEL 0-100 -> 0.0-1.0, PAN 0-100 -> balance (centre = full level on both sides)
+    // (balance on the front pair, channels 0/1; any further channels take the level)
+    tap.level = level / 100.0f;
+    tap.pan = pan / 100.0f;
+    tap.levelGains = Lanes::expand(tap.level);
 
-        // CEILING (invariant - see domain.md, GitHub #5)
-        // Clamp feedback only, not dry input - preserves transients
-        feedbackL = juce::jlimit(-FB_WRITE_LIMIT, FB_WRITE_LIMIT, feedbackL);
-        feedbackR = juce::jlimit(-FB_WRITE_LIMIT, FB_WRITE_LIMIT, feedbackR);
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel)
+    {
+        const float gain = channel == 0 ? tap.level * std::min(1.0f, 2.0f * (1.0f - tap.pan))
+                         : channel == 1 ? tap.level * std::min(1.0f, 2.0f * tap.pan)
+                         : tap.level;
+        tap.gains[static_cast<size_t>(channel / LANES)].set(static_cast<size_t>(channel % LANES), gain);
+    }
 
-        // Get dry input
-        float dryL = leftChannel[i];
-        float dryR = rightChannel ? rightChannel[i] : dryL;
+    const bool active = tap.level > 0.0f;
+    bool orderChanged = active != tap.active;
 
-        // Write to delay buffer (input + feedback)
-        int wp = writePos % MAX_DELAY_SAMPLES;
-        delayBufferL[wp] = dryL + feedbackL;
-        delayBufferR[wp] = dryR + feedbackR;
+    // Tempo-synced to the bpm last passed to setDelayTime()
+    if (noteValue != tap.noteValue || lastBpm != tap.bpm)
+    {
+        tap.noteValue = noteValue;
+        tap.bpm = lastBpm;
+        countCoefficientUpdate();
 
-        // Mix dry/wet and apply output gain
-        float wetL = filteredL * outputGain;
-        float wetR = filteredR * outputGain;
+        const float delayMs = std::clamp(calculateNoteDivisionMs(noteValue, lastBpm), 1.0f, MAX_DELAY_MS);
+        tap.targetSamples = std::max(static_cast<float>(delayMs * currentSampleRate / 1000.0), 1.0f);
 
-        leftChannel[i] = dryL * (1.0f - wetMix) + wetL * wetMix;
-        if (rightChannel)
-            rightChannel[i] = dryR * (1.0f - wetMix) + wetR * wetMix;
+        // Glide like the TIME tap while audible, otherwise just jump
+        tap.smoothingOffset = tap.delaySamples - tap.targetSamples;
+        if (tap.smoothingOffset != 0.0f)
+            tap.settled = false;
 
-        writePos++;
-        if (writePos >= MAX_DELAY_SAMPLES)
-            writePos = 0;
+        orderChanged = true;
     }
+
+    if (active && ! tap.active)
+        settleTap(tap);  // Switched on from level 0 - start on its target
+
+    tap.active = active;
+
+    if (orderChanged)
+        updateTapOrder();
 }
 
-float DubDelay::readDelay(const std::array<float, MAX_DELAY_SAMPLES>& buffer, float delaySamples)
+template <typename SampleType>
+void DubDelay<SampleType>::setWowFlutter(float depth, float rate, float drift)
 {
-    // Cubic interpolation for smooth delay time changes
-    float readPos = static_cast<float>(writePos) - delaySamples;
-    while (readPos < 0) readPos += MAX_DELAY_SAMPLES;
+    wowFlutter.setDepth(depth);
+    wowFlutter.setRate(rate);
+    wowFlutter.setDrift(drift);
+}
+
+template <typename SampleType>
+bool DubDelay<SampleType>::canReadSinc(int wholeDelay, int validSamples) const noexcept
+{
+    // All taps written (newest before writeIndex) and none masked by reset()
+    return wholeDelay >= WindowedSinc<SampleType>::HALF_TAPS
+        && wholeDelay + WindowedSinc<SampleType>::HALF_TAPS <= validSamples;
+}
 
-    int pos0 = static_cast<int>(readPos) % MAX_DELAY_SAMPLES;
-    int pos1 = (pos0 + 1) % MAX_DELAY_SAMPLES;
-    int posM1 = (pos0 - 1 + MAX_DELAY_SAMPLES) % MAX_DELAY_SAMPLES;
-    int pos2 = (pos0 + 2) % MAX_DELAY_SAMPLES;
+template <typename SampleType>
+template <bool HighQuality>
+SampleType DubDelay<SampleType>::readDelay(const std::vector<SampleType>& buffer, int writeIndex, float delaySamples, int validSamples) const
+{
+    // Cubic interpolation for smooth delay time changes.
+    // Split the delay into whole + fractional samples so the read position
+    // keeps full precision however far writeIndex has advanced:
+    // writeIndex - (n + f) = (writeIndex - n - 1) + (1 - f)
+    const int wholeDelay = static_cast<int>(delaySamples);
+    const SampleType frac = SampleType(1) - (delaySamples - static_cast<float>(wholeDelay));
+
+    // Offline tier: windowed sinc over the same split (falls back to the
+    // cubic for the few reads too close to writeIndex or to a reset)
+    if constexpr (HighQuality)
+    {
+        if (canReadSinc(wholeDelay, validSamples))
+        {
+            typename WindowedSinc<SampleType>::Weights weights;
+            WindowedSinc<SampleType>::weights(frac, weights);
+            return WindowedSinc<SampleType>::read(buffer.data(), writeIndex - wholeDelay - WindowedSinc<SampleType>::HALF_TAPS,
+                                                  delayMask, weights);
+        }
+    }
 
-    float frac = readPos - std::floor(readPos);
+    const int pos0 = (writeIndex - wholeDelay - 1) & delayMask;
+    const int pos1 = (pos0 + 1) & delayMask;
+    const int posM1 = (pos0 - 1) & delayMask;
+    const int pos2 = (pos0 + 2) & delayMask;
 
     // Cubic interpolation (Catmull-Rom)
-    float y0 = buffer[posM1];
-    float y1 = buffer[pos0];
-    float y2 = buffer[pos1];
-    float y3 = buffer[pos2];
+    SampleType y0 = buffer[posM1];
+    SampleType y1 = buffer[pos0];
+    SampleType y2 = buffer[pos1];
+    SampleType y3 = buffer[pos2];
+
+    // Shortly after reset() the oldest taps (up to wholeDelay + 2 behind the
+    // write index) may still hold pre-reset audio: treat those as silence
+    if (wholeDelay + 2 > validSamples)
+    {
+        y0 = 0.0f;
+        y1 = wholeDelay + 1 <= validSamples ? y1 : 0.0f;
+        y2 = wholeDelay <= validSamples ? y2 : 0.0f;
+        y3 = wholeDelay - 1 <= validSamples ? y3 : 0.0f;
+    }
 
-    float a0 = -0.5f * y0 + 1.5f * y1 - 1.5f * y2 + 0.5f * y3;
-    float a1 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
-    float a2 = -0.5f * y0 + 0.5f * y2;
-    float a3 = y1;
+    SampleType a0 = -0.5f * y0 + 1.5f * y1 - 1.5f * y2 + 0.5f * y3;
+    SampleType a1 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+    SampleType a2 = -0.5f * y0 + 0.5f * y2;
+    SampleType a3 = y1;
 
     return a0 * frac * frac * frac + a1 * frac * frac + a2 * frac + a3;
 }
 
-float DubDelay::softClip(float x)
+template <typename SampleType>
+SampleType DubDelay<SampleType>::softClip(SampleType x)
+{
+    // Soft saturation using tanh (bounded-error rational, see FastTanh.h)
+    return FastTanh::process(x);
+}
+
+//==============================================================================
+// Softclip anti-aliasing
+
+template <typename SampleType>
+void DubDelay<SampleType>::saturate(Lanes* frames, int numSamples, int stride, int channels)
+{
+    switch (activeSaturationQuality)
+    {
+        case SaturationQuality::adaa:
+            saturateADAA(frames, numSamples, stride, channels);
+            break;
+
+        case SaturationQuality::oversample2x:
+        case SaturationQuality::oversample4x:
+            saturateOversampled(frames, numSamples, stride, channels);
+            break;
+
+        case SaturationQuality::standard:
+        default:
+            for (int group = 0; group < groupCount(channels); ++group)
+                FastTanh::process(reinterpret_cast<SampleType*>(frames + group * stride), numSamples * LANES);
+            break;
+    }
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::saturateADAA(Lanes* frames, int numSamples, int stride, int channels)
+{
+    // First-order ADAA: y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]) with
+    // F(x) = log(cosh(x)), the antiderivative of tanh. F is evaluated in the
+    // overflow-safe form |x| + log1p(exp(-2|x|)) (the - log(2) term cancels
+    // in the difference), in double because the quotient cancels badly in float.
+    constexpr double ADAA_EPSILON = 1.0e-5;
+    const auto logCosh = [] (double x)
+    {
+        const double ax = std::abs(x);
+        return ax + std::log1p(std::exp(-2.0 * ax));
+    };
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        Lanes* channelFrames = frames + (channel / LANES) * stride;
+        const auto lane = static_cast<size_t>(channel % LANES);
+        double previous = adaaPrevious[static_cast<size_t>(channel)];
+        double previousF = logCosh(previous);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x = channelFrames[i].get(lane);
+            const double dx = x - previous;
+            const double fx = logCosh(x);
+
+            // Ill-conditioned for tiny steps: tanh at the midpoint is the limit
+            const SampleType y = std::abs(dx) > ADAA_EPSILON
+                               ? static_cast<SampleType>((fx - previousF) / dx)
+                               : FastTanh::process(static_cast<SampleType>(0.5 * (x + previous)));
+
+            channelFrames[i].set(lane, y);
+            previous = x;
+            previousF = fx;
+        }
+
+        adaaPrevious[static_cast<size_t>(channel)] = static_cast<SampleType>(previous);
+    }
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::saturateOversampled(Lanes* frames, int numSamples, int stride, int channels)
+{
+    // Only the nonlinearity runs at the higher rate: de-interleave the
+    // channels, upsample, tanh, downsample, re-interleave
+    SampleType* scratch[MAX_CHANNELS] = {};
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        const Lanes* channelFrames = frames + (channel / LANES) * stride;
+        const auto lane = static_cast<size_t>(channel % LANES);
+        scratch[channel] = saturationScratch.getWritePointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            scratch[channel][i] = channelFrames[i].get(lane);
+    }
+
+    juce::dsp::AudioBlock<SampleType> block (scratch, static_cast<size_t>(channels), static_cast<size_t>(numSamples));
+    auto upsampled = activeOversampler->processSamplesUp(block);
+
+    for (size_t ch = 0; ch < upsampled.getNumChannels(); ++ch)
+        FastTanh::process(upsampled.getChannelPointer(ch), static_cast<int>(upsampled.getNumSamples()));
+
+    activeOversampler->processSamplesDown(block);
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        Lanes* channelFrames = frames + (channel / LANES) * stride;
+        const auto lane = static_cast<size_t>(channel % LANES);
+
+        for (int i = 0; i < numSamples; ++i)
+            channelFrames[i].set(lane, scratch[channel][i]);
+    }
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setSaturationQuality(SaturationQuality quality)
+{
+    if (quality == saturationQuality)
+        return;
+
+    saturationQuality = quality;
+    countCoefficientUpdate();
+
+    // Nothing in the loop yet (just reset) or asleep: nothing to move
+    updateActiveSaturation(sleeping || primedSamples == 0);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::updateActiveSaturation(bool atRest)
+{
+    const auto quality = renderQuality == RenderQuality::offline ? SaturationQuality::oversample4x : saturationQuality;
+    if (quality == activeSaturationQuality)
+        return;
+
+    // A new latency moves every read position in a running loop - hold the
+    // switch until reset() or sleep (applyRenderQuality() picks it up)
+    auto* oversampler = getOversampler(quality);
+    const int latency = oversampler != nullptr ? static_cast<int>(oversampler->getLatencyInSamples()) : 0;
+    if (! atRest && latency != loopLatency)
+        return;
+
+    activeSaturationQuality = quality;
+
+    // Start the new mode from clean state (same latency, or a silent loop,
+    // so nothing audible is cut)
+    adaaPrevious.fill(SampleType(0));
+    updateLoopLatency();
+
+    if (activeOversampler != nullptr)
+        activeOversampler->reset();
+    std::fill(dryCompensation.begin(), dryCompensation.end(), Lanes {});
+    dryCompensationPos = 0;
+
+    // Read position moved with the latency - rebuild the fixed taps
+    if (delaySettled)
+        settleDelay();
+    for (auto& tap : extraTaps)
+        if (tap.settled)
+            settleTap(tap);
+
+    DBG("DubDelay: saturationQuality=" + juce::String(static_cast<int>(quality))
+        + " loopLatency=" + juce::String(loopLatency));
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setRenderQuality(RenderQuality quality)
+{
+    pendingRenderQuality = quality;
+
+    // Asleep the loop is silent, so there's nothing to wait for
+    if (sleeping)
+        applyRenderQuality();
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::applyRenderQuality()
+{
+    if (pendingRenderQuality != renderQuality)
+    {
+        renderQuality = pendingRenderQuality;
+
+        // Sinc weights for the fixed taps (rebuilt anyway if the latency moves)
+        if (delaySettled)
+            settleDelay();
+        for (auto& tap : extraTaps)
+            if (tap.settled)
+                settleTap(tap);
+
+        DBG("DubDelay: renderQuality=" + juce::String(static_cast<int>(renderQuality)));
+    }
+
+    // Called at rest points only - also takes up a deferred saturation switch
+    updateActiveSaturation(true);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::updateLoopLatency()
+{
+    activeOversampler = getOversampler(activeSaturationQuality);
+    loopLatency = activeOversampler != nullptr
+                ? static_cast<int>(activeOversampler->getLatencyInSamples())
+                : 0;
+}
+
+template <typename SampleType>
+juce::dsp::Oversampling<SampleType>* DubDelay<SampleType>::getOversampler(SaturationQuality quality) const
+{
+    switch (quality)
+    {
+        case SaturationQuality::oversample2x: return oversampler2x.get();
+        case SaturationQuality::oversample4x: return oversampler4x.get();
+        case SaturationQuality::standard:
+        case SaturationQuality::adaa:
+        default:                              return nullptr;
+    }
+}
+
+template <typename SampleType>
+float DubDelay<SampleType>::readDelayTime(float delaySamples) const
+{
+    // Shorter than the delay by the softclip latency (the loop adds it back).
+    // Extremely short delays can't absorb all of it; keep at least one sample.
+    return std::max(delaySamples - static_cast<float>(loopLatency), 1.0f);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::compensateDry(Lanes* dry, int groups) noexcept
 {
-    // Soft saturation using tanh
-    return std::tanh(x);
+    // In place: the frame in, the one from loopLatency samples ago out
+    const int mask = static_cast<int>(dryCompensation.size()) / MAX_GROUPS - 1;
+    Lanes* slot = dryCompensation.data() + dryCompensationPos * MAX_GROUPS;
+    const Lanes* delayed = dryCompensation.data() + ((dryCompensationPos - loopLatency) & mask) * MAX_GROUPS;
+
+    for (int group = 0; group < groups; ++group)
+    {
+        slot[group] = dry[group];
+        dry[group] = delayed[group];
+    }
+
+    dryCompensationPos = (dryCompensationPos + 1) & mask;
 }
 
-float DubDelay::calculateNoteDivisionMs(float noteValue, double bpm)
+template <typename SampleType>
+float DubDelay<SampleType>::calculateNoteDivisionMs(float noteValue, double bpm)
 {
     // noteValue 1-96 maps to note divisions
     // 96 = whole note, 48 = half, 24 = quarter, 12 = eighth, 6 = sixteenth, etc.
@@ -224,8 +1706,25 @@ float DubDelay::calculateNoteDivisionMs(float noteValue, double bpm)
     return static_cast<float>(quarterNoteMs * quarterNotes);
 }
 
-void DubDelay::setDelayTime(float timeValue, bool tempoSync, double bpm)
+template <typename SampleType>
+void DubDelay<SampleType>::countCoefficientUpdate()
 {
+    // Only the audio thread writes, so a relaxed load/store is enough
+    coefficientUpdateCount.store(coefficientUpdateCount.load(std::memory_order_relaxed) + 1,
+                                 std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setDelayTime(float timeValue, bool tempoSync, double bpm)
+{
+    if (timeValue == lastTimeValue && tempoSync == lastTempoSync && (! tempoSync || bpm == lastBpm))
+        return;
+
+    lastTimeValue = timeValue;
+    lastTempoSync = tempoSync;
+    lastBpm = bpm;
+    countCoefficientUpdate();
+
     float delayMs;
 
     if (tempoSync)
@@ -238,83 +1737,208 @@ void DubDelay::setDelayTime(float timeValue, bool tempoSync, double bpm)
         delayMs = timeValue;
     }
 
-    // Clamp to reasonable range
-    delayMs = std::clamp(delayMs, 1.0f, 4000.0f);
+    // Clamp to reasonable range (ring capacity is sized from MAX_DELAY_MS)
+    delayMs = std::clamp(delayMs, 1.0f, MAX_DELAY_MS);
 
     targetDelayTimeSamples = static_cast<float>(delayMs * currentSampleRate / 1000.0);
-    targetDelayTimeSamples = std::clamp(targetDelayTimeSamples, 1.0f, static_cast<float>(MAX_DELAY_SAMPLES - 1));
+    targetDelayTimeSamples = std::max(targetDelayTimeSamples, 1.0f);
+
+    // New target: glide from the current position, back on the smoothing
+    // path until it converges again
+    delaySmoothingOffset = delayTimeSamples - targetDelayTimeSamples;
+
+    if (delaySmoothingOffset != 0.0f)
+        delaySettled = false;
 
     // Update degradation characteristics based on delay time
     // PT2399 degrades at longer delay times
     // At 30ms: full bandwidth (~15kHz)
     // At 500ms+: reduced bandwidth (~3kHz)
-    float degradeCutoff = juce::jmap(delayMs, 30.0f, 500.0f, 15000.0f, 3000.0f);
+    degradeCutoff = juce::jmap(delayMs, 30.0f, 500.0f, 15000.0f, 3000.0f);
     degradeCutoff = std::clamp(degradeCutoff, 2000.0f, 15000.0f);
-    degradeLPL.setCutoffFrequency(degradeCutoff);
-    degradeLPR.setCutoffFrequency(degradeCutoff);
+    for (auto& lowpass : degradeLP)
+        lowpass.setPrewarpedCutoff(coefficientTables->prewarp(degradeCutoff));
 
     // Sample rate reduction period increases with delay time
     holdPeriod = static_cast<int>(juce::jmap(delayMs, 30.0f, 500.0f, 1.0f, 4.0f));
     holdPeriod = std::max(1, holdPeriod);
 }
 
-void DubDelay::setFeedback(float fb)
+template <typename SampleType>
+void DubDelay<SampleType>::setFeedback(float fb)
 {
     // 0-100 -> 0.0-0.95 (capped below unity to prevent runaway)
     // See: GitHub issue #3
     feedback = fb / 100.0f * 0.95f;
 }
 
-void DubDelay::setDegradation(float degrad)
+template <typename SampleType>
+void DubDelay<SampleType>::setDegradation(float degrad)
 {
     // 0-100 -> 0.0-1.0
     degradation = degrad / 100.0f;
 }
 
-void DubDelay::setFilterType(bool is24dB)
+template <typename SampleType>
+void DubDelay<SampleType>::setFilterType(bool is24dB)
 {
     filter24dB = is24dB;
 }
 
-void DubDelay::setFilterFrequency(float freq)
+template <typename SampleType>
+void DubDelay<SampleType>::setFilterTopology(FilterTopology topology)
+{
+    for (auto& bank : bandpass)
+        bank.setTopology(topology);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::updateFilterCoefficients()
+{
+    // Re-derive every filter from the stored settings (new sample rate)
+    for (int group = 0; group < MAX_GROUPS; ++group)
+    {
+        bandpass[static_cast<size_t>(group)].setPrewarpedCutoff(coefficientTables->prewarp(filterFreq));
+        bandpass[static_cast<size_t>(group)].setDamping(1.0 / filterQ);
+        degradeLP[static_cast<size_t>(group)].setPrewarpedCutoff(coefficientTables->prewarp(degradeCutoff));
+        feedbackLP[static_cast<size_t>(group)].setPrewarpedCutoff(coefficientTables->prewarp(FEEDBACK_LPF_FREQ));
+    }
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setFilterFrequency(float freq)
 {
+    if (freq == lastFilterFreq)
+        return;
+
+    lastFilterFreq = freq;
+    countCoefficientUpdate();
+
     filterFreq = std::clamp(freq, 300.0f, 3000.0f);
-    filterL1.setCutoffFrequency(filterFreq);
-    filterR1.setCutoffFrequency(filterFreq);
-    filterL2.setCutoffFrequency(filterFreq);
-    filterR2.setCutoffFrequency(filterFreq);
+    for (auto& bank : bandpass)
+        bank.setPrewarpedCutoff(coefficientTables->prewarp(filterFreq));
 }
 
-void DubDelay::setFilterBandwidth(float q)
+template <typename SampleType>
+void DubDelay<SampleType>::setFilterBandwidth(float q)
 {
+    if (q == lastFilterBandwidth)
+        return;
+
+    lastFilterBandwidth = q;
+    countCoefficientUpdate();
+
     // Q of 0.0-4.0 -> resonance 0.5-5.0
-    filterQ = juce::jmap(q, 0.0f, 4.0f, 0.5f, 5.0f);
-    filterL1.setResonance(filterQ);
-    filterR1.setResonance(filterQ);
-    filterL2.setResonance(filterQ);
-    filterR2.setResonance(filterQ);
+    filterQ = CoefficientTables::bandwidthToResonance(q);
+    for (auto& bank : bandpass)
+        bank.setDamping(coefficientTables->damping(q));
 }
 
-void DubDelay::setGain(float gainDb)
+template <typename SampleType>
+void DubDelay<SampleType>::setGain(float gainDb)
 {
+    if (gainDb == lastGainDb)
+        return;
+
+    lastGainDb = gainDb;
+    countCoefficientUpdate();
+
     // -12 to +12 dB
     outputGain = juce::Decibels::decibelsToGain(gainDb);
 }
 
-void DubDelay::setPanLR(float pan)
+template <typename SampleType>
+void DubDelay<SampleType>::setPanLR(float pan)
 {
     // 0-100 -> 0.0-1.0
     panLR = pan / 100.0f;
+    updatePingPong();
 }
 
-void DubDelay::setPanRL(float pan)
+template <typename SampleType>
+void DubDelay<SampleType>::setPanRL(float pan)
 {
     // 0-100 -> 0.0-1.0
     panRL = pan / 100.0f;
+    updatePingPong();
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setPingPongRing(const std::vector<int>& channels)
+{
+    // Clear the old ring's entries, then spread the pans over the new one
+    for (int k = 0; k < pingPongLength; ++k)
+        setCrossfeedGain(pingPongRing[static_cast<size_t>(k)], pingPongRing[static_cast<size_t>((k + 1) % pingPongLength)], 0.0f);
+
+    pingPongLength = 0;
+    for (const int channel : channels)
+    {
+        jassert(channel >= 0 && channel < MAX_CHANNELS);
+        if (channel >= 0 && channel < MAX_CHANNELS && pingPongLength < MAX_CHANNELS)
+            pingPongRing[static_cast<size_t>(pingPongLength++)] = channel;
+    }
+
+    updatePingPong();
 }
 
-void DubDelay::setMix(float mix)
+template <typename SampleType>
+void DubDelay<SampleType>::updatePingPong()
+{
+    // Each ring position feeds the next: even positions by panLR, odd by panRL
+    if (pingPongLength < 2)
+        return;
+
+    for (int k = 0; k < pingPongLength; ++k)
+        setCrossfeedGain(pingPongRing[static_cast<size_t>(k)], pingPongRing[static_cast<size_t>((k + 1) % pingPongLength)],
+                         k % 2 == 0 ? panLR : panRL);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setCrossfeed(int fromChannel, int toChannel, float amount)
+{
+    jassert(fromChannel != toChannel);
+    if (fromChannel == toChannel || fromChannel < 0 || toChannel < 0 || fromChannel >= MAX_CHANNELS || toChannel >= MAX_CHANNELS)
+        return;
+
+    // 0-100 -> 0.0-1.0
+    setCrossfeedGain(fromChannel, toChannel, amount / 100.0f);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setCrossfeedGain(int fromChannel, int toChannel, float gain)
+{
+    if (fromChannel == toChannel)
+        return;
+
+    crossfeedMatrix[static_cast<size_t>(toChannel)][static_cast<size_t>(fromChannel)] = gain;
+    crossfeedColumns[static_cast<size_t>(fromChannel)][static_cast<size_t>(toChannel / LANES)]
+        .set(static_cast<size_t>(toChannel % LANES), static_cast<SampleType>(gain));
+
+    // The stereo kernels' 2x2 case (swapped lanes)
+    if (fromChannel == 1 && toChannel == 0)
+        crossfeedGains.set(0, gain);
+    else if (fromChannel == 0 && toChannel == 1)
+        crossfeedGains.set(1, gain);
+}
+
+template <typename SampleType>
+void DubDelay<SampleType>::setMix(float mix)
 {
     // 0-100 -> 0.0-1.0
     wetMix = mix / 100.0f;
 }
+
+//==============================================================================
+template class DubDelay<float>;
+template class DubDelay<double>;
+
+// Read kernels on their own (member templates aren't covered by the class
+// instantiations above) - for the CLI tool's benchmark
+template float DubDelay<float>::readDelay<false>(const std::vector<float>&, int, float, int) const;
+template float DubDelay<float>::readDelay<true>(const std::vector<float>&, int, float, int) const;
+template double DubDelay<double>::readDelay<false>(const std::vector<double>&, int, float, int) const;
+template double DubDelay<double>::readDelay<true>(const std::vector<double>&, int, float, int) const;
+template float DubDelay<float>::readSettled<false>(const std::vector<float>&, const FixedTap&, int, int) const;
+template float DubDelay<float>::readSettled<true>(const std::vector<float>&, const FixedTap&, int, int) const;
+template double DubDelay<double>::readSettled<false>(const std::vector<double>&, const FixedTap&, int, int) const;
+template double DubDelay<double>::readSettled<true>(const std::vector<double>&, const FixedTap&, int, int) const;
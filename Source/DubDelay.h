@@ -2,25 +2,61 @@
 
 #include <juce_dsp/juce_dsp.h>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include "FastTanh.h"
+#include "BandpassBank.h"
+#include "CoefficientTables.h"
+#include "WowFlutter.h"
+#include "WindowedSinc.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <vector>
 
 /**
  * DubDelay - PT2399-style dub tape delay engine
  *
  * Features:
- * - Stereo delay with ping-pong
+ * - Mono, stereo or up to MAX_CHANNELS (quad, 5.1, 7.1) with ping-pong
+ *   crossfeed: an NxN feedback matrix, the PAN knobs being its 2x2 case
  * - Degradation (lo-fi at longer delay times, mimicking PT2399)
  * - Bandpass filter in feedback loop
  * - Tempo sync
+ * - Multi-tap: up to MAX_TAPS read heads on the one ring, summed into the
+ *   shared filter/feedback chain
+ * - Wow/flutter: PT2399 clock instability modulating every read head
+ * - Offline render tier: windowed-sinc reads and oversampled softclip while
+ *   the host bounces (see RenderQuality)
+ *
+ * Processing runs in one of two engines per block:
+ * - Staged: when the delay is longer than the block, nothing written this
+ *   block can be read back in it, so each stage runs as its own pass over
+ *   contiguous scratch buffers (read, degrade, bandpass, feedback, write/mix).
+ * - Per-sample: very short delays, where a read can hit this block's writes.
+ *
+ * Channels run in SIMD lanes: stereo is one register (lane 0 = L, 1 = R),
+ * more channels take ceil(N / lanes) registers per frame (channel c in
+ * group c / lanes, lane c % lanes), so the filters and the crossfeed
+ * matrix-vector product cost one register operation per group, not per
+ * channel.
+ *
+ * Templated on the sample type (float or double, instantiated in
+ * DubDelay.cpp) so hosts with a 64-bit mix engine run without conversion
+ * and long feedback tails keep double precision. Parameters and delay times
+ * stay float; ring, filter state and all signal math use SampleType.
  */
+template <typename SampleType>
 class DubDelay
 {
 public:
     DubDelay();
     ~DubDelay() = default;
 
-    void prepare(double sampleRate, int samplesPerBlock);
-    void reset();
-    void process(juce::AudioBuffer<float>& buffer);
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels = 2);  // Rings for numChannels (at least 2)
+    void reset();                               // O(1), safe on the audio thread
+    void skipResetFade();                       // Fresh start (nothing playing before): no fade-in after reset()
+    void release();                             // Free the ring and scratch (process() is a no-op until prepare())
+    void process(juce::AudioBuffer<SampleType>& buffer);
 
     // Parameters
     void setDelayTime(float timeValue, bool tempoSync, double bpm);  // 1-96 for sync, or ms
@@ -29,22 +65,145 @@ public:
     void setFilterType(bool is24dB);            // false=12dB, true=24dB
     void setFilterFrequency(float freq);        // 300-3000 Hz
     void setFilterBandwidth(float q);           // 0.0-4.0
+
+    // Bandpass realisation (same response: TPT SVF or cookbook biquad)
+    using FilterTopology = typename BandpassBank<SampleType>::Topology;
+    void setFilterTopology(FilterTopology topology);
     void setGain(float gainDb);                 // -12 to +12 dB
     void setPanLR(float pan);                   // 0-100 (left to right crossfeed)
     void setPanRL(float pan);                   // 0-100 (right to left crossfeed)
+
+    // Crossfeed matrix. The feedback written into a channel is
+    // FEEDBACK x (its own filtered repeat + sum of crossfeed x every other
+    // channel's). The PAN knobs own the entries along the ping-pong ring:
+    // each ring position feeds the next (wrapping around), even positions
+    // by panLR and odd ones by panRL - with the default ring 0, 1 in stereo
+    // that is exactly L -> R = panLR, R -> L = panRL. Other entries are
+    // free for setCrossfeed() and start at 0.
+    static constexpr int MAX_CHANNELS = 8;     // 7.1
+    void setCrossfeed(int fromChannel, int toChannel, float amount);  // 0-100, fromChannel != toChannel
+    void setPingPongRing(const std::vector<int>& channels);           // prepare() sets 0 .. numChannels - 1
     void setMix(float mix);                     // 0-100 (dry to wet)
 
+    // Land on the delay target now instead of gliding there (program
+    // changes): the old read position is crossfaded out over CROSSFADE_MS.
+    // Call after setDelayTime(); jumps under CROSSFADE_MIN_JUMP_MS still glide.
+    void crossfadeDelayTime();
+
+    // Multi-tap: extra read heads on the same ring buffer. Tap 0 is the TIME
+    // tap above; taps 1..MAX_TAPS-1 are tempo-synced to the bpm passed to
+    // setDelayTime() and are off while their level is 0.
+    static constexpr int MAX_TAPS = 8;
+    void setTap(int tapIndex, float noteValue, float level, float pan);  // 1-96, 0-100, 0-100 (50 = centre)
+
+    // Wow/flutter (see WowFlutter.h). Off, at no cost, while depth is 0.
+    void setWowFlutter(float depth, float rate, float drift);          // 0-100 each
+
+    // Anti-aliasing for the feedback softclip (CPU vs quality, per instance)
+    enum class SaturationQuality
+    {
+        standard = 0,   // tanh at the host rate
+        adaa,           // First-order antiderivative anti-aliasing
+        oversample2x,   // juce::dsp::Oversampling around the softclip only
+        oversample4x
+    };
+    // Switches that change the loop latency (into or out of the oversampled
+    // modes) would move every read position, so they take effect at the next
+    // reset() or once the loop has fallen silent (at once before any audio)
+    void setSaturationQuality(SaturationQuality quality);
+
+    // Render tier. Offline (host bouncing, no deadline) reads every tap with
+    // a windowed sinc instead of Catmull-Rom and forces 4x oversampled
+    // saturation over the SaturationQuality setting. A new tier is picked up
+    // at the next reset() or while the engine sleeps - both points where the
+    // loop holds no audible history - so changing it never glitches.
+    enum class RenderQuality
+    {
+        realtime = 0,
+        offline
+    };
+    void setRenderQuality(RenderQuality quality);
+    RenderQuality getRenderQuality() const { return renderQuality; }
+
+    // Plugin latency (dry and wet). Oversampling delay inside the feedback
+    // loop is compensated on the read side, so this stays 0.
+    int getLatencySamples() const { return 0; }
+
+    // Setters are called every block; unchanged values are skipped. This counts
+    // the calls that actually recomputed coefficients (safe from any thread).
+    juce::uint32 getCoefficientUpdateCount() const { return coefficientUpdateCount.load(std::memory_order_relaxed); }
+
+    // True while the engine is idling (silent input and fully decayed tail)
+    bool isSleeping() const { return sleeping; }
+
+    // Time for the wet output to fall below -TAIL_FLOOR_DB after the input
+    // stops, from the current settings. An upper bound, so a host that stops
+    // calling process() after it never cuts a tail; infinity while the loop
+    // gain can reach 1 (the softclip then sustains a self-oscillation).
+    static constexpr double TAIL_FLOOR_DB = 90.0;
+    double getTailLengthSeconds() const;
+
+    // Which engine processed the last chunk of the last process() call
+    enum class EnginePath
+    {
+        staged = 0,
+        perSample,
+        sleeping
+    };
+    EnginePath getLastEnginePath() const { return lastEnginePath; }
+
 private:
-    // Delay buffers
-    static constexpr int MAX_DELAY_SAMPLES = 192000 * 4;  // 4 seconds at 192kHz
+    // Tools/KingDubbyCli times readDelay() and softClip() on their own
+    friend struct DubDelayBenchmark;
+
+    // Channel groups: one Lanes register holds LANES channels of a frame
+    using Lanes = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int LANES = static_cast<int>(Lanes::size());
+    static constexpr int MAX_GROUPS = (MAX_CHANNELS + LANES - 1) / LANES;
+    static constexpr int groupCount(int channels) noexcept { return (channels + LANES - 1) / LANES; }
+
+    // Delay buffers - allocated in prepare() for the actual sample rate,
+    // power-of-two capacity so indices wrap with a bitmask
+    static constexpr float MAX_DELAY_MS = 4000.0f;
+    static constexpr int INTERPOLATION_MARGIN = 4;  // Catmull-Rom taps around the read point
+    static constexpr int SINC_MARGIN = WindowedSinc<SampleType>::TAPS;  // Same for the offline tier
 
     // Feedback write-back ceiling (invariant - see domain.md)
     // Guarantees stability regardless of EQ/saturation behavior
     static constexpr float FB_WRITE_LIMIT = 0.95f;
-    std::array<float, MAX_DELAY_SAMPLES> delayBufferL{};
-    std::array<float, MAX_DELAY_SAMPLES> delayBufferR{};
+    std::array<std::vector<SampleType>, MAX_CHANNELS> delayBuffers;  // One ring per prepared channel
+    int preparedChannels = 2;
+    int delayMask = 0;  // capacity - 1
     int writePos = 0;
 
+    // reset() doesn't touch the rings: anything older than primedSamples is
+    // stale and reads as silence until it has been overwritten
+    int primedSamples = 0;  // Samples written since reset (saturates at capacity)
+
+    // Output fade-in after reset (replaces the old silent block)
+    static constexpr float RESET_FADE_MS = 5.0f;
+    int resetFadeLength = 1;
+    int resetFadeRemaining = 0;
+
+    // Delay-jump crossfade (see crossfadeDelayTime()): the TIME tap reads both
+    // the outgoing and the new position and blends linearly between them
+    static constexpr float CROSSFADE_MS = 30.0f;
+    static constexpr float CROSSFADE_MIN_JUMP_MS = 1.0f;
+    int crossfadeLength = 1;
+    int crossfadeRemaining = 0;
+    float crossfadeFromSamples = 1.0f;  // Outgoing delay time
+
+    // Sleep mode: once input and wet path (feedback written into the ring and
+    // filtered output) stay below SLEEP_THRESHOLD for longer than the delay,
+    // blocks skip the chain and only apply the dry gain. The ring and write
+    // position are frozen, so the first loud block resumes on a silent tail.
+    static constexpr float SLEEP_THRESHOLD = 1.0e-5f;  // -100 dBFS
+    bool sleeping = false;
+    int quietSamples = 0;   // Consecutive samples with input and wet path below threshold
+    float wetPeak = 0.0f;   // Wet-path peak of the last processed chunk
+    void updateSleepState(float inputPeak, int numSamples);
+    void processSleeping(SampleType* const* channels, int numSamples) const;
+
     // Sample rate
     double currentSampleRate = 44100.0;
 
@@ -52,6 +211,32 @@ private:
     float delayTimeSamples = 22050.0f;  // 500ms default
     float targetDelayTimeSamples = 22050.0f;
 
+    // One-pole smoothing, kept as the distance to the target: the same
+    // recurrence as d = d * c + t * (1 - c), but it converges to exactly
+    // zero instead of stalling up to ~2 samples short when (t - d) * (1 - c)
+    // drops below half an ulp of d
+    static constexpr float DELAY_SMOOTHING = 0.9995f;  // Coefficient per sample
+    float delaySmoothingOffset = 0.0f;  // delayTimeSamples - targetDelayTimeSamples
+
+    // Settled-delay fast path: once the smoother has converged on its target
+    // the read offset and interpolation weights are constant, so reads skip the
+    // smoother and the per-sample interpolation setup. Left again as soon as
+    // setDelayTime() produces a new target (TIME or host BPM change).
+    static constexpr float SETTLE_THRESHOLD = 1.0e-3f;  // Samples - snap when closer than this
+    struct FixedTap
+    {
+        float readTime = 1.0f;              // Fallback for masked taps after reset()
+        int wholeDelay = 0;
+        bool isInteger = true;              // Single tap, no interpolation
+        SampleType w0 = 0, w1 = 0, w2 = 1, w3 = 0;  // Catmull-Rom weights for y[-1..2]
+        typename WindowedSinc<SampleType>::Weights sinc {};  // Offline tier only
+    };
+    FixedTap settledTap;
+    bool delaySettled = false;
+    void settleDelay();
+    void updateDelaySettling();
+    FixedTap makeFixedTap(float readTime) const;
+
     // Parameters
     float feedback = 0.5f;
     float degradation = 0.0f;
@@ -63,25 +248,221 @@ private:
     float panRL = 0.0f;
     float wetMix = 0.5f;
 
-    // Filters (state variable filter for flexibility)
-    juce::dsp::StateVariableTPTFilter<float> filterL1, filterR1;
-    juce::dsp::StateVariableTPTFilter<float> filterL2, filterR2;  // For 24dB mode
+    // Ping-pong ring the pans are spread over (see setPingPongRing)
+    std::array<int, MAX_CHANNELS> pingPongRing {};
+    int pingPongLength = 0;
+    void updatePingPong();
+
+    // Change detection - last raw setter inputs (NaN = never set / invalidated)
+    static constexpr float UNSET = std::numeric_limits<float>::quiet_NaN();
+    float lastTimeValue = UNSET;
+    bool lastTempoSync = true;
+    double lastBpm = 0.0;
+    float lastFilterFreq = UNSET;
+    float lastFilterBandwidth = UNSET;
+    float lastGainDb = UNSET;
+    std::atomic<juce::uint32> coefficientUpdateCount { 0 };
+    void countCoefficientUpdate();
+
+    // Stereo lanes: L and R run in lockstep with identical coefficients, so
+    // both channels share one SIMD register (lane 0 = L, lane 1 = R)
+    static_assert(Lanes::size() >= 2, "DubDelay needs at least two SIMD lanes");
+    static_assert(sizeof(Lanes) == sizeof(SampleType) * Lanes::size(), "Lanes scratch is processed as raw samples");
+
+    /**
+     * TPT state-variable filter, same topology and coefficients as
+     * juce::dsp::StateVariableTPTFilter, with the state held in Lanes so
+     * one update filters both channels. The cutoff comes in prewarped
+     * (g = tan(pi fc / fs), see CoefficientTables).
+     */
+    class LaneSVF
+    {
+    public:
+        void setType(juce::dsp::StateVariableTPTFilterType newType) { type = newType; }
+        void setPrewarpedCutoff(double newG) { update(newG); }
+        void reset() { s1 = 0.0f; s2 = 0.0f; }
+
+        Lanes processSample(Lanes x) noexcept
+        {
+            const Lanes yHP = h * (x - s1 * (g + R2) - s2);
+            const Lanes yBP = yHP * g + s1;
+            s1 = yHP * g + yBP;
+            const Lanes yLP = yBP * g + s2;
+            s2 = yBP * g + yLP;
+            return type == juce::dsp::StateVariableTPTFilterType::lowpass ? yLP : yBP;
+        }
+
+    private:
+        void update(double gValue);
+
+        juce::dsp::StateVariableTPTFilterType type = juce::dsp::StateVariableTPTFilterType::lowpass;
+        static constexpr float RESONANCE = 1.0f / juce::MathConstants<float>::sqrt2;  // Butterworth
+        Lanes g {}, R2 {}, h {};
+        Lanes s1 {}, s2 {};
+    };
+
+    // Filter and degradation state below is one instance per channel group
+
+    // Bandpass filter in feedback path (second stage for 24dB mode)
+    std::array<BandpassBank<SampleType>, MAX_GROUPS> bandpass;
+
+    // Prewarp/damping tables for the current sample rate, shared by every
+    // instance at that rate (never null - the constructor takes the 44.1k set)
+    std::shared_ptr<const CoefficientTables> coefficientTables;
+    void updateFilterCoefficients();
 
     // Degradation lowpass (simulates PT2399 bandwidth reduction)
-    juce::dsp::StateVariableTPTFilter<float> degradeLPL, degradeLPR;
+    std::array<LaneSVF, MAX_GROUPS> degradeLP;
+    float degradeCutoff = 1000.0f;  // Hz, follows the delay time (setDelayTime)
 
     // Feedback-path LPF (darkens repeats, prevents harsh buildup)
     // After softclip to catch edge harmonics. See: GitHub issue #4, domain.md
-    juce::dsp::StateVariableTPTFilter<float> feedbackLPL, feedbackLPR;
+    std::array<LaneSVF, MAX_GROUPS> feedbackLP;
     static constexpr float FEEDBACK_LPF_FREQ = 6000.0f;  // Hz (lowered from 8k for more taming)
 
+    // Largest gain of the loop's filters (bandpass and lowpasses) over
+    // frequency, for the tail estimate
+    double getLoopFilterGain() const;
+
+    // Softclip anti-aliasing (see SaturationQuality). The active mode is the
+    // setting, or oversample4x on the offline tier. A switch that moves the
+    // loop latency waits for a rest point (atRest: reset(), sleep or an
+    // empty loop).
+    SaturationQuality saturationQuality = SaturationQuality::standard;
+    SaturationQuality activeSaturationQuality = SaturationQuality::standard;
+    void updateActiveSaturation(bool atRest);
+
+    // Render tier in use, and the one requested (applied by applyRenderQuality())
+    RenderQuality renderQuality = RenderQuality::realtime;
+    RenderQuality pendingRenderQuality = RenderQuality::realtime;
+    void applyRenderQuality();
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler2x, oversampler4x;
+    juce::dsp::Oversampling<SampleType>* activeOversampler = nullptr;
+    juce::AudioBuffer<SampleType> saturationScratch;  // De-interleaved channels for the oversampler
+    std::array<SampleType, MAX_CHANNELS> adaaPrevious {};  // Last softclip input per channel
+
+    // The oversampler delays the softclip output by loopLatency samples. Reads
+    // run that much earlier and the dry signal written into the ring is held
+    // back by the same amount, so the loop time and wet output stay exact.
+    int loopLatency = 0;
+    std::vector<Lanes> dryCompensation;          // Power-of-two ring of MAX_GROUPS-register frames
+    int dryCompensationPos = 0;
+    void updateLoopLatency();
+    juce::dsp::Oversampling<SampleType>* getOversampler(SaturationQuality quality) const;
+    float readDelayTime(float delaySamples) const;
+    void compensateDry(Lanes* dry, int numGroups) noexcept;
+
+    // Softclip over numSamples frames of the first `channels` channels, group
+    // g's frames starting at frames + g * stride
+    void saturate(Lanes* frames, int numSamples, int stride, int channels);
+    void saturateADAA(Lanes* frames, int numSamples, int stride, int channels);
+    void saturateOversampled(Lanes* frames, int numSamples, int stride, int channels);
+
+    // Stereo crossfeed gains in swapped-lane order: lane 0 = R->L, lane 1 = L->R
+    Lanes crossfeedGains {};
+
+    // Crossfeed matrix [to][from], and per source channel its column as
+    // registers over the destination groups (1 on the diagonal) for the
+    // multichannel kernels' matrix-vector product
+    std::array<std::array<float, MAX_CHANNELS>, MAX_CHANNELS> crossfeedMatrix {};
+    std::array<std::array<Lanes, MAX_GROUPS>, MAX_CHANNELS> crossfeedColumns {};
+    void setCrossfeedGain(int fromChannel, int toChannel, float gain);
+
     // Sample-and-hold for degradation (sample rate reduction)
-    float holdL = 0.0f, holdR = 0.0f;
+    std::array<Lanes, MAX_GROUPS> hold {};
     int holdCounter = 0;
     int holdPeriod = 1;
 
-    // Helper functions
-    float readDelay(const std::array<float, MAX_DELAY_SAMPLES>& buffer, float delaySamples);
-    float softClip(float x);
+    // Extra taps (see setTap). Same smoothing and settled fast path as the
+    // TIME tap, plus a per-lane gain for level and pan.
+    struct ExtraTap
+    {
+        float noteValue = UNSET;            // Change detection (NaN = recompute)
+        float level = 0.0f;
+        float pan = 0.5f;
+        double bpm = 0.0;
+        bool active = false;
+
+        float delaySamples = 1.0f;
+        float targetSamples = 1.0f;
+        float smoothingOffset = 0.0f;       // delaySamples - targetSamples
+        FixedTap fixed;
+        bool settled = false;
+
+        std::array<Lanes, MAX_GROUPS> gains {};  // Level with balance pan on channels 0/1 (L/R), level on the rest
+        Lanes levelGains {};                // Mono: level on every lane
+    };
+    std::array<ExtraTap, MAX_TAPS - 1> extraTaps;
+
+    // Active extra taps, sorted by delay so consecutive tap passes read
+    // neighbouring stretches of the ring (see readExtraTaps)
+    std::array<int, MAX_TAPS - 1> tapOrder {};
+    int numActiveTaps = 0;
+    void updateTapOrder();
+    void settleTap(ExtraTap& tap);
+    void updateTapSettling();
+    template <int Channels, bool HighQuality> void readExtraTaps(Lanes* wet, int numSamples);
+    template <int Channels, bool HighQuality> void readExtraTapsSample(Lanes* delayed, float clock);
+
+    // TIME tap blend during a delay-jump crossfade (staged / per-sample)
+    template <int Channels, bool HighQuality> void crossfadeRead(Lanes* wet, int numSamples);
+    template <int Channels, bool HighQuality> void crossfadeReadSample(Lanes* delayed, float clock);
+
+    // Wow/flutter: relative clock deviation per sample of the current chunk,
+    // filled in process() only while the section is active. All read heads
+    // then take the modulated path (delay * (1 + deviation)) instead of the
+    // settled fast path.
+    WowFlutter wowFlutter;
+    std::vector<float> modulationScratch;
+    bool modulationActive = false;
+
+    // Block engine scratch: per channel group, one frame per sample (group g's
+    // block at g * maxBlockSize; sized from samplesPerBlock in prepare)
+    std::vector<Lanes> wetScratch, feedbackScratch;
+    int maxBlockSize = 512;
+
+    // Engines, each compiled per <Channels, Filter24dB, DegradeOn, HighQuality>
+    // and picked once per block by selectKernel() (HighQuality = offline tier).
+    // Channels is 1, 2 or MULTICHANNEL: 3..MAX_CHANNELS, counted at run time
+    // (numChannels / numGroups of the current process() call).
+    static constexpr float DEGRADE_THRESHOLD = 0.001f;  // Below this the degrade stage is skipped
+    static constexpr int MULTICHANNEL = 0;
+    int ringChannels = 2;  // Channels the rings were last run with (kernels leave the others untouched)
+    int numChannels = 2;
+    int numGroups = 1;
+    EnginePath lastEnginePath = EnginePath::staged;
+    using Kernel = void (DubDelay::*)(SampleType* const*, int);
+    Kernel selectKernel(bool staged, int channels) const;
+    bool canProcessStaged(int numSamples) const;
+    int getStagedRunLength() const;
+    float getShortestReadDelay() const;  // Minus loop latency and interpolation read-ahead
+    template <int Channels, bool Filter24dB, bool DegradeOn, bool HighQuality>
+    void processStaged(SampleType* const* channels, int numSamples);
+    template <int Channels, bool Filter24dB, bool DegradeOn, bool HighQuality>
+    void processPerSample(SampleType* const* channels, int numSamples);
+
+    // Per-frame stages shared by both engines. A frame is one register per
+    // channel group, group g at frame[g * stride].
+    template <int Channels> int groupsFor() const noexcept { return Channels == MULTICHANNEL ? numGroups : 1; }
+    template <int Channels> int saturationChannels() const noexcept { return Channels == MULTICHANNEL ? numChannels : 2; }
+    template <int Channels, typename Read> void loadFrames(Lanes* frame, int stride, Read&& read) const;
+    template <int Channels, typename Read> void addFrames(Lanes* frame, int stride, const Lanes* gains, Read&& read) const;
+    static Lanes makeFrame(SampleType left, SampleType right) noexcept;
+    template <int Channels> static Lanes loadFrame(SampleType left, SampleType right) noexcept;
+    template <int Channels> float framePeak(const Lanes* peak) const noexcept;
+    static Lanes swapChannels(Lanes x) noexcept;
+    template <int Channels> void degradeFrame(Lanes* frame, int stride) noexcept;
+    template <int Channels> void feedbackGainFrame(const Lanes* filtered, int filteredStride, Lanes* out, int outStride) const noexcept;
+    Lanes feedbackCeiling(Lanes x) const noexcept;
+
+    // Helper functions (HighQuality reads use the windowed sinc where the
+    // taps it needs are valid, Catmull-Rom otherwise)
+    template <bool HighQuality>
+    SampleType readDelay(const std::vector<SampleType>& buffer, int writeIndex, float delaySamples, int validSamples) const;
+    template <bool HighQuality>
+    SampleType readSettled(const std::vector<SampleType>& buffer, const FixedTap& tap, int writeIndex, int validSamples) const;
+    bool canReadSinc(int wholeDelay, int validSamples) const noexcept;
+    void applyResetFade(SampleType* const* channels, int numSamples);
+    SampleType softClip(SampleType x);
     float calculateNoteDivisionMs(float noteValue, double bpm);
 };
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+
+/**
+ * FactoryPresets - built-in program bank
+ *
+ * Compiled-in parameter sets for the host's program list
+ * (setCurrentProgram()). A preset covers the panel controls plus
+ * wow/flutter and switches the extra taps off; the per-instance quality
+ * settings (saturation quality, filter topology) are left alone. Values use
+ * the parameter ranges (same as ParameterSnapshot).
+ */
+struct FactoryPreset
+{
+    const char* name;
+    float time;             // 1-96 (24 = quarter note)
+    float feedback;         // 0-100
+    float degradation;      // 0-100
+    bool filter24dB;
+    float filterFreq;       // 300-3000 Hz
+    float filterBandwidth;  // 0.0-4.0
+    float gainDb;           // -12 to +12 dB
+    float panLR;            // 0-100
+    float panRL;            // 0-100
+    float mix;              // 0-100
+    float wowDepth;         // 0-100
+    float wowRate;          // 0-100
+    float wowDrift;         // 0-100
+};
+
+inline constexpr std::array<FactoryPreset, 8> FACTORY_PRESETS
+{{
+    //  name                 time  fdbk  degr  24dB   freq    bw    gain  L-R    R-L    mix   wow   rate  drift
+    { "Init",                24.0f, 50.0f,  0.0f, false, 1000.0f, 2.0f,  0.0f,   0.0f,   0.0f, 50.0f,  0.0f, 50.0f,  0.0f },
+    { "Quarter Skank",       24.0f, 55.0f, 15.0f, false, 1200.0f, 1.5f,  0.0f,   0.0f,   0.0f, 40.0f, 10.0f, 30.0f,  0.0f },
+    { "Dotted Ping-Pong",    18.0f, 60.0f, 10.0f, false, 1500.0f, 2.0f,  0.0f, 100.0f, 100.0f, 45.0f,  0.0f, 50.0f,  0.0f },
+    { "Tubby Eighths",       12.0f, 75.0f, 35.0f, true,   800.0f, 2.5f, -2.0f,  30.0f,  30.0f, 50.0f, 20.0f, 40.0f, 10.0f },
+    { "Siren Runaway",        6.0f, 95.0f, 20.0f, true,  2200.0f, 3.5f,  0.0f,  50.0f,  50.0f, 55.0f,  5.0f, 60.0f,  0.0f },
+    { "Worn Tape Wash",      48.0f, 70.0f, 60.0f, false,  700.0f, 1.0f,  0.0f,  20.0f,  20.0f, 50.0f, 45.0f, 25.0f, 40.0f },
+    { "Slapback",             3.0f, 10.0f,  5.0f, false, 2500.0f, 0.5f,  0.0f,   0.0f,   0.0f, 35.0f,  0.0f, 50.0f,  0.0f },
+    { "Triplet Drift",       16.0f, 65.0f, 25.0f, false, 1000.0f, 2.0f,  0.0f,  60.0f,  60.0f, 50.0f, 15.0f, 50.0f, 25.0f }
+}};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "DubDelay.h"
+#include <array>
+
+/**
+ * ParameterSnapshot - every DubDelay parameter at one instant
+ *
+ * Built by KingDubbyAudioProcessor whenever a parameter changes (by the
+ * audio thread at the top of the next block, or by the message thread while
+ * no blocks run), so processBlock() works on one consistent set per block
+ * instead of loading each atomic on its own.
+ * Values are the raw parameter values (same ranges as the setters).
+ * applyTo() pushes a snapshot into an engine (the processor, and the
+ * command-line renderer, which runs DubDelay without a processor).
+ */
+struct ParameterSnapshot
+{
+    float time = 24.0f;             // 1-96
+    float feedback = 50.0f;         // 0-100
+    float degradation = 0.0f;       // 0-100
+    bool filter24dB = false;
+    float filterFreq = 1000.0f;     // 300-3000 Hz
+    float filterBandwidth = 2.0f;   // 0.0-4.0
+    float gainDb = 0.0f;            // -12 to +12 dB
+    float panLR = 0.0f;             // 0-100
+    float panRL = 0.0f;             // 0-100
+    float mix = 50.0f;              // 0-100
+
+    int saturationQuality = 0;      // DubDelay::SaturationQuality
+    int filterTopology = 0;         // DubDelay::FilterTopology
+
+    float wowDepth = 0.0f;          // 0-100
+    float wowRate = 50.0f;          // 0-100
+    float wowDrift = 0.0f;          // 0-100
+
+    // Program changes published so far - a new count tells the audio thread
+    // to jump (crossfaded) to the new delay time rather than glide
+    juce::uint32 programChanges = 0;
+
+    // Parameter edits this set reflects (the processor's edit counter when it
+    // was built), so an older set never replaces a newer one
+    juce::uint32 parameterEdits = 0;
+
+    // Extra taps 2..MAX_TAPS
+    struct Tap
+    {
+        float time = 24.0f;         // 1-96
+        float level = 0.0f;         // 0-100
+        float pan = 50.0f;          // 0-100
+    };
+    std::array<Tap, DubDelay<float>::MAX_TAPS - 1> taps {};
+
+    // Every setter; the synced delay and taps follow bpm
+    template <typename SampleType>
+    void applyTo(DubDelay<SampleType>& engine, double bpm) const
+    {
+        engine.setDelayTime(time, true, bpm);
+        engine.setFeedback(feedback);
+        engine.setDegradation(degradation);
+        engine.setFilterType(filter24dB);
+        engine.setFilterFrequency(filterFreq);
+        engine.setFilterBandwidth(filterBandwidth);
+        engine.setFilterTopology(static_cast<typename DubDelay<SampleType>::FilterTopology>(filterTopology));
+        engine.setGain(gainDb);
+        engine.setPanLR(panLR);
+        engine.setPanRL(panRL);
+        engine.setMix(mix);
+        engine.setWowFlutter(wowDepth, wowRate, wowDrift);
+        engine.setSaturationQuality(static_cast<typename DubDelay<SampleType>::SaturationQuality>(saturationQuality));
+
+        for (int tap = 1; tap < DubDelay<SampleType>::MAX_TAPS; ++tap)
+        {
+            const auto& p = taps[static_cast<size_t>(tap - 1)];
+            engine.setTap(tap, p.time, p.level, p.pan);
+        }
+    }
+};
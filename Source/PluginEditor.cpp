@@ -12,10 +12,13 @@ KingDubbyAudioProcessorEditor::KingDubbyAudioProcessorEditor(KingDubbyAudioProce
     // Set fixed size - no resizing allowed
     setResizable(false, false);
     setSize(711, 348);
+
+    setPerformanceHudVisible(showPerformanceHud);
 }
 
 KingDubbyAudioProcessorEditor::~KingDubbyAudioProcessorEditor()
 {
+    stopTimer();
 }
 
 void KingDubbyAudioProcessorEditor::loadImages()
@@ -347,6 +350,9 @@ void KingDubbyAudioProcessorEditor::paintOverChildren(juce::Graphics& g)
         drawCross("MIX", juce::Colours::springgreen, *mixKnob);
     }
 
+    if (showPerformanceHud)
+        paintPerformanceHud(g);
+
     // Footer disabled for now
     // TODO: Re-enable when DSP is refined
     /*
@@ -377,8 +383,96 @@ void KingDubbyAudioProcessorEditor::paintOverChildren(juce::Graphics& g)
     footerBounds = juce::Rectangle<int>();  // Empty bounds, no clickable area
 }
 
+juce::Rectangle<int> KingDubbyAudioProcessorEditor::getPerformanceHudBounds() const
+{
+    return { 6, 6, 300, 52 };
+}
+
+void KingDubbyAudioProcessorEditor::paintPerformanceHud(juce::Graphics& g)
+{
+    const auto bounds = getPerformanceHudBounds();
+    g.setColour(juce::Colours::black.withAlpha(0.75f));
+    g.fillRoundedRectangle(bounds.toFloat(), 4.0f);
+
+    auto percent = [] (float load) { return juce::String(load * 100.0f, 1) + "%"; };
+
+    juce::String path = "-";
+    if (hudStats.numBlocks > 0)
+    {
+        switch (static_cast<DubDelay<float>::EnginePath>(hudStats.enginePath))
+        {
+            case DubDelay<float>::EnginePath::staged:    path = "staged"; break;
+            case DubDelay<float>::EnginePath::perSample: path = "per-sample"; break;
+            case DubDelay<float>::EnginePath::sleeping:  path = "sleeping"; break;
+            default: break;
+        }
+        path << (audioProcessor.isRunningDoubleEngine() ? " (64-bit)" : " (32-bit)");
+        if (audioProcessor.isNonRealtime())
+            path << " offline";
+    }
+
+    const juce::String lines[] =
+    {
+        "DSP load  min " + percent(hudStats.minLoad) + "  mean " + percent(hudStats.meanLoad)
+            + "  p99 " + percent(hudStats.p99Load) + "  max " + percent(hudStats.maxLoad),
+        ">50% blocks " + juce::String(hudStats.blocksOverBudget) + "  resets " + juce::String(hudStats.resetCount)
+            + "  blocks " + juce::String(static_cast<juce::int64>(hudStats.totalBlocks)),
+        "path " + path + "  (last " + juce::String(hudStats.numBlocks) + " blocks)"
+    };
+
+    g.setColour(hudStats.p99Load > DspLoadMonitor::OVER_BUDGET_LOAD ? juce::Colours::orange : juce::Colours::white);
+    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 10.0f, juce::Font::plain));
+
+    auto textArea = bounds.reduced(6, 4);
+    for (const auto& line : lines)
+        g.drawText(line, textArea.removeFromTop(14), juce::Justification::left, false);
+}
+
+void KingDubbyAudioProcessorEditor::setPerformanceHudVisible(bool shouldBeVisible)
+{
+    showPerformanceHud = shouldBeVisible;
+
+    if (showPerformanceHud)
+    {
+        hudStats = audioProcessor.getLoadMonitor().getStats();
+        startTimerHz(HUD_REFRESH_HZ);
+    }
+    else
+    {
+        stopTimer();
+    }
+
+    repaint(getPerformanceHudBounds());
+}
+
+void KingDubbyAudioProcessorEditor::timerCallback()
+{
+    hudStats = audioProcessor.getLoadMonitor().getStats();
+    repaint(getPerformanceHudBounds());
+}
+
+void KingDubbyAudioProcessorEditor::showContextMenu()
+{
+    juce::PopupMenu menu;
+    menu.addItem(1, "Show performance HUD", true, showPerformanceHud);
+
+    juce::Component::SafePointer<KingDubbyAudioProcessorEditor> safeThis(this);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this),
+                       [safeThis] (int result)
+                       {
+                           if (safeThis != nullptr && result == 1)
+                               safeThis->setPerformanceHudVisible(! safeThis->showPerformanceHud);
+                       });
+}
+
 void KingDubbyAudioProcessorEditor::mouseUp(const juce::MouseEvent& e)
 {
+    if (e.mods.isPopupMenu())
+    {
+        showContextMenu();
+        return;
+    }
+
     if (footerBounds.contains(e.getPosition()))
     {
         juce::URL("https://scalenavigator.com").launchInDefaultBrowser();
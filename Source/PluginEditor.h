@@ -6,7 +6,8 @@
 #include "FilmstripKnob.h"
 #include "LayoutMap.h"
 
-class KingDubbyAudioProcessorEditor : public juce::AudioProcessorEditor
+class KingDubbyAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                      private juce::Timer
 {
 public:
     explicit KingDubbyAudioProcessorEditor(KingDubbyAudioProcessor&);
@@ -79,5 +80,16 @@ private:
     // Debug flag - set to true only when debugging UI positioning
     static constexpr bool kShowUiDebug = false;
 
+    // Performance HUD (DSP load of this instance), toggled from the
+    // right-click menu; stats are polled on a timer while it is visible
+    bool showPerformanceHud = kShowUiDebug;
+    DspLoadMonitor::Stats hudStats;
+    static constexpr int HUD_REFRESH_HZ = 4;
+    void setPerformanceHudVisible(bool shouldBeVisible);
+    void showContextMenu();
+    void paintPerformanceHud(juce::Graphics& g);
+    juce::Rectangle<int> getPerformanceHudBounds() const;
+    void timerCallback() override;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KingDubbyAudioProcessorEditor)
 };
@@ -12,6 +12,28 @@ const juce::String KingDubbyAudioProcessor::PARAM_GAIN = "gain";
 const juce::String KingDubbyAudioProcessor::PARAM_PAN_LR = "panLR";
 const juce::String KingDubbyAudioProcessor::PARAM_PAN_RL = "panRL";
 const juce::String KingDubbyAudioProcessor::PARAM_MIX = "mix";
+const juce::String KingDubbyAudioProcessor::PARAM_SAT_QUALITY = "satQuality";
+const juce::String KingDubbyAudioProcessor::PARAM_FILTER_TOPOLOGY = "filterTopology";
+const juce::String KingDubbyAudioProcessor::PARAM_WOW_DEPTH = "wowDepth";
+const juce::String KingDubbyAudioProcessor::PARAM_WOW_RATE = "wowRate";
+const juce::String KingDubbyAudioProcessor::PARAM_WOW_DRIFT = "wowDrift";
+
+juce::String KingDubbyAudioProcessor::getTapParamID(int tapNumber, const juce::String& name)
+{
+    return "tap" + juce::String(tapNumber) + name;
+}
+
+std::vector<int> KingDubbyAudioProcessor::getPingPongRing(const juce::AudioChannelSet& layout)
+{
+    std::vector<int> ring;
+    for (int channel = 0; channel < std::max(1, layout.size()); ++channel)
+    {
+        const auto type = layout.getTypeOfChannel(channel);
+        if (type != juce::AudioChannelSet::LFE && type != juce::AudioChannelSet::LFE2)
+            ring.push_back(channel);
+    }
+    return ring;
+}
 
 KingDubbyAudioProcessor::KingDubbyAudioProcessor()
     : AudioProcessor(BusesProperties()
@@ -30,10 +52,153 @@ KingDubbyAudioProcessor::KingDubbyAudioProcessor()
     panLRParam = apvts.getRawParameterValue(PARAM_PAN_LR);
     panRLParam = apvts.getRawParameterValue(PARAM_PAN_RL);
     mixParam = apvts.getRawParameterValue(PARAM_MIX);
+    satQualityParam = apvts.getRawParameterValue(PARAM_SAT_QUALITY);
+    filterTopologyParam = apvts.getRawParameterValue(PARAM_FILTER_TOPOLOGY);
+    wowDepthParam = apvts.getRawParameterValue(PARAM_WOW_DEPTH);
+    wowRateParam = apvts.getRawParameterValue(PARAM_WOW_RATE);
+    wowDriftParam = apvts.getRawParameterValue(PARAM_WOW_DRIFT);
+
+    for (int tap = 1; tap < DubDelay<float>::MAX_TAPS; ++tap)
+    {
+        auto& p = tapParams[static_cast<size_t>(tap - 1)];
+        p.time = apvts.getRawParameterValue(getTapParamID(tap + 1, "Time"));
+        p.level = apvts.getRawParameterValue(getTapParamID(tap + 1, "Level"));
+        p.pan = apvts.getRawParameterValue(getTapParamID(tap + 1, "Pan"));
+        p.levelParameter = apvts.getParameter(getTapParamID(tap + 1, "Level"));
+    }
+
+    binaryState = std::make_unique<BinaryState>(getParameters());
+
+    // Count every parameter change; the next block (or the idle timer) rebuilds the set
+    for (auto* parameter : getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            apvts.addParameterListener(ranged->paramID, this);
+
+    blockParameters = getParameterSnapshot();
+    startTimer(PUBLISH_INTERVAL_MS);
 }
 
 KingDubbyAudioProcessor::~KingDubbyAudioProcessor()
 {
+    stopTimer();
+
+    for (auto* parameter : getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            apvts.removeParameterListener(ranged->paramID, this);
+}
+
+void KingDubbyAudioProcessor::parameterChanged(const juce::String& /*parameterID*/, float /*newValue*/)
+{
+    // Any thread, the audio thread included (VST3 automation): no work here
+    parameterEdits.fetch_add(1);
+}
+
+void KingDubbyAudioProcessor::timerCallback()
+{
+    updateProgramParameters();
+    announceTailLength();
+
+    // Idle updates only: while blocks run, the audio thread catches up itself
+    const auto edits = parameterEdits.load();
+    if (edits != appliedEdits.load() && edits != lastPublishedEdits)
+        publishParameters();
+}
+
+void KingDubbyAudioProcessor::publishParameters()
+{
+    // Rebuild the whole set from the parameter atomics (they are updated
+    // before listeners are called). Nothing goes out while a program or a
+    // state restore is going in, or if one ran during the rebuild - the next
+    // tick tries again. The set is tagged with the program it was built
+    // under, so the audio thread drops it if a newer program got there first.
+    const auto edits = parameterEdits.load();
+    const auto loads = parameterLoads.load();
+    if (pendingProgram.load() >= 0)
+        return;
+
+    auto params = getParameterSnapshot();
+    params.programChanges = programChangeCount.load();
+    params.parameterEdits = edits;
+
+    if ((loads & 1) != 0 || parameterLoads.load() != loads)
+        return;
+
+    parameterSnapshots.write(params);
+    lastPublishedEdits = edits;
+}
+
+bool KingDubbyAudioProcessor::refreshParameters()
+{
+    // Audio thread (or prepareToPlay(), which never overlaps it). Takes a
+    // new program, then an idle update from the timer if it is newer than
+    // the current set, then rebuilds from the parameter atomics if they were
+    // edited since - no later than the block after the change. Not while a
+    // program's values or a state restore are still going in (or overlap
+    // the rebuild): the next block picks those up.
+    bool changed = false;
+
+    bool published = false;
+    const auto& program = programSnapshots.read(published);
+    if (published)
+    {
+        blockParameters = program;
+        changed = true;
+    }
+
+    const auto& idle = parameterSnapshots.read(published);
+    if (published && idle.programChanges == blockParameters.programChanges
+                  && isNewer(idle.parameterEdits, blockParameters.parameterEdits))
+    {
+        blockParameters = idle;
+        changed = true;
+    }
+
+    const auto edits = parameterEdits.load();
+    const auto loads = parameterLoads.load();
+    if (edits != blockParameters.parameterEdits && (loads & 1) == 0 && pendingProgram.load() < 0)
+    {
+        auto params = getParameterSnapshot();
+        params.programChanges = blockParameters.programChanges;
+        params.parameterEdits = edits;
+
+        if (parameterLoads.load() == loads)
+        {
+            blockParameters = params;
+            changed = true;
+        }
+    }
+
+    appliedEdits.store(blockParameters.parameterEdits);
+    return changed;
+}
+
+ParameterSnapshot KingDubbyAudioProcessor::getParameterSnapshot() const
+{
+    ParameterSnapshot params;
+    params.time = timeParam->load();
+    params.feedback = feedbackParam->load();
+    params.degradation = degradParam->load();
+    params.filter24dB = filterTypeParam->load() > 0.5f;
+    params.filterFreq = filterFreqParam->load();
+    params.filterBandwidth = filterBWParam->load();
+    params.gainDb = gainParam->load();
+    params.panLR = panLRParam->load();
+    params.panRL = panRLParam->load();
+    params.mix = mixParam->load();
+    params.saturationQuality = static_cast<int>(satQualityParam->load());
+    params.filterTopology = static_cast<int>(filterTopologyParam->load());
+    params.wowDepth = wowDepthParam->load();
+    params.wowRate = wowRateParam->load();
+    params.wowDrift = wowDriftParam->load();
+
+    for (size_t tap = 0; tap < params.taps.size(); ++tap)
+    {
+        params.taps[tap].time = tapParams[tap].time->load();
+        params.taps[tap].level = tapParams[tap].level->load();
+        params.taps[tap].pan = tapParams[tap].pan->load();
+    }
+
+    return params;
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout KingDubbyAudioProcessor::createParameterLayout()
@@ -119,6 +284,73 @@ juce::AudioProcessorValueTreeState::ParameterLayout KingDubbyAudioProcessor::cre
         50.0f
     ));
 
+    // SATURATION QUALITY: feedback softclip anti-aliasing (host-only, no panel control)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(PARAM_SAT_QUALITY, 1),
+        "Saturation Quality",
+        juce::StringArray { "Standard", "ADAA", "Oversample 2x", "Oversample 4x" },
+        0  // Default: Standard (original sound and CPU cost)
+    ));
+
+    // FILTER TOPOLOGY: bandpass realisation, same response (host-only)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(PARAM_FILTER_TOPOLOGY, 1),
+        "Filter Topology",
+        juce::StringArray { "SVF", "Biquad" },
+        0  // Default: SVF (original filter)
+    ));
+
+    // WOW/FLUTTER DEPTH: 0-100 (host-only, 0 = off)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(PARAM_WOW_DEPTH, 1),
+        "Wow/Flutter Depth",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        0.0f  // Default: off (original sound)
+    ));
+
+    // WOW/FLUTTER RATE: 0-100 (host-only)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(PARAM_WOW_RATE, 1),
+        "Wow/Flutter Rate",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        50.0f
+    ));
+
+    // WOW/FLUTTER DRIFT: 0-100, random clock wander (host-only)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(PARAM_WOW_DRIFT, 1),
+        "Wow/Flutter Drift",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        0.0f
+    ));
+
+    // EXTRA TAPS 2..MAX_TAPS: division, level, pan (host-only, off at level 0)
+    for (int tapNumber = 2; tapNumber <= DubDelay<float>::MAX_TAPS; ++tapNumber)
+    {
+        const juce::String tapName = "Tap " + juce::String(tapNumber) + " ";
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(getTapParamID(tapNumber, "Time"), 1),
+            tapName + "Time",
+            juce::NormalisableRange<float>(1.0f, 96.0f, 1.0f),
+            24.0f  // Default: quarter note
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(getTapParamID(tapNumber, "Level"), 1),
+            tapName + "Level",
+            juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+            0.0f  // Default: off
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(getTapParamID(tapNumber, "Pan"), 1),
+            tapName + "Pan",
+            juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+            50.0f  // Default: centre
+        ));
+    }
+
     return { params.begin(), params.end() };
 }
 
@@ -144,26 +376,125 @@ bool KingDubbyAudioProcessor::isMidiEffect() const
 
 double KingDubbyAudioProcessor::getTailLengthSeconds() const
 {
-    return 4.0;  // Max delay time
+    // Decay time of the current settings (see processBlockInternal()). Knob
+    // moves aren't announced: JUCE has no tail flag, and the latency flag
+    // would make VST3 hosts restart the plugin - resetting the loop - every
+    // time. Hosts pick the new value up on their next query.
+    return tailLengthSeconds.load();
+}
+
+void KingDubbyAudioProcessor::announceTailLength()
+{
+    // Program changes and state restores are where hosts expect the plugin's
+    // reported state to move, so the tail goes out with the program flag -
+    // once the audio thread has estimated it for the loaded set
+    if (! tailAnnouncePending.load() || pendingProgram.load() >= 0 || appliedEdits.load() != parameterEdits.load())
+        return;
+
+    tailAnnouncePending.store(false);
+    updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+}
+
+template <typename SampleType>
+void KingDubbyAudioProcessor::updateTailLength(DubDelay<SampleType>& engine)
+{
+    // Hosts read the tail when they activate the plugin, so estimate it from
+    // the current set before the first block. prepareToPlay() never overlaps
+    // processBlock(), so it can take the audio thread's side here.
+    refreshParameters();
+    blockParameters.applyTo(engine, lastAppliedBpm > 0.0 ? lastAppliedBpm : 120.0);
+    tailLengthSeconds.store(roundUpTail(engine.getTailLengthSeconds()));
 }
 
 int KingDubbyAudioProcessor::getNumPrograms()
 {
-    return 1;
+    return static_cast<int>(FACTORY_PRESETS.size());
 }
 
 int KingDubbyAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram.load();
+}
+
+void KingDubbyAudioProcessor::setCurrentProgram(int index)
+{
+    if (index < 0 || index >= getNumPrograms())
+        return;
+
+    // Any thread, the audio thread included: atomics and a TripleBuffer write
+    // only. The preset's set goes straight to the audio thread; the
+    // parameters (and the host's view of them) follow on the message thread.
+    const auto& preset = FACTORY_PRESETS[static_cast<size_t>(index)];
+
+    auto params = getParameterSnapshot();   // Quality settings and tap times/pans carry over
+    params.time = preset.time;
+    params.feedback = preset.feedback;
+    params.degradation = preset.degradation;
+    params.filter24dB = preset.filter24dB;
+    params.filterFreq = preset.filterFreq;
+    params.filterBandwidth = preset.filterBandwidth;
+    params.gainDb = preset.gainDb;
+    params.panLR = preset.panLR;
+    params.panRL = preset.panRL;
+    params.mix = preset.mix;
+    params.wowDepth = preset.wowDepth;
+    params.wowRate = preset.wowRate;
+    params.wowDrift = preset.wowDrift;
+
+    for (auto& tap : params.taps)
+        tap.level = 0.0f;
+
+    pendingProgram.store(index);
+    params.programChanges = programChangeCount.fetch_add(1) + 1;
+    params.parameterEdits = parameterEdits.load();
+    programSnapshots.write(params);
+    currentProgram.store(index);
+}
+
+void KingDubbyAudioProcessor::updateProgramParameters()
+{
+    const int index = pendingProgram.load();
+    if (index < 0)
+        return;
+
+    const auto& preset = FACTORY_PRESETS[static_cast<size_t>(index)];
+
+    setProgramParameter(apvts.getParameter(PARAM_TIME), preset.time);
+    setProgramParameter(apvts.getParameter(PARAM_FEEDBACK), preset.feedback);
+    setProgramParameter(apvts.getParameter(PARAM_DEGRAD), preset.degradation);
+    setProgramParameter(apvts.getParameter(PARAM_FILTER_TYPE), preset.filter24dB ? 1.0f : 0.0f);
+    setProgramParameter(apvts.getParameter(PARAM_FILTER_FREQ), preset.filterFreq);
+    setProgramParameter(apvts.getParameter(PARAM_FILTER_BW), preset.filterBandwidth);
+    setProgramParameter(apvts.getParameter(PARAM_GAIN), preset.gainDb);
+    setProgramParameter(apvts.getParameter(PARAM_PAN_LR), preset.panLR);
+    setProgramParameter(apvts.getParameter(PARAM_PAN_RL), preset.panRL);
+    setProgramParameter(apvts.getParameter(PARAM_MIX), preset.mix);
+    setProgramParameter(apvts.getParameter(PARAM_WOW_DEPTH), preset.wowDepth);
+    setProgramParameter(apvts.getParameter(PARAM_WOW_RATE), preset.wowRate);
+    setProgramParameter(apvts.getParameter(PARAM_WOW_DRIFT), preset.wowDrift);
+
+    for (auto& tap : tapParams)
+        setProgramParameter(tap.levelParameter, 0.0f);
+
+    // Snapshots from the parameters resume - unless another program came in
+    // meanwhile (the next call moves that one in)
+    int expected = index;
+    pendingProgram.compare_exchange_strong(expected, -1);
+    tailAnnouncePending.store(true);
 }
 
-void KingDubbyAudioProcessor::setCurrentProgram(int /*index*/)
+void KingDubbyAudioProcessor::setProgramParameter(juce::RangedAudioParameter* parameter, float value)
 {
+    if (parameter != nullptr)
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
 }
 
-const juce::String KingDubbyAudioProcessor::getProgramName(int /*index*/)
+const juce::String KingDubbyAudioProcessor::getProgramName(int index)
 {
-    return {};
+    if (index < 0 || index >= getNumPrograms())
+        return {};
+
+    return FACTORY_PRESETS[static_cast<size_t>(index)].name;
 }
 
 void KingDubbyAudioProcessor::changeProgramName(int /*index*/, const juce::String& /*newName*/)
@@ -172,13 +503,50 @@ void KingDubbyAudioProcessor::changeProgramName(int /*index*/, const juce::Strin
 
 void KingDubbyAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    dubDelay.prepare(sampleRate, samplesPerBlock);
+    // Offline bounces have no deadline: run double-precision state even for a
+    // 32-bit host, on the engine's offline tier (taken up by the reset in prepare())
+    const bool offline = isNonRealtime();
+    floatHostOnDoubleEngine.store(offline && ! isUsingDoublePrecision());
+
+    // One ring per channel of the layout, ping-pong around all but the LFE
+    const auto layout = getChannelLayoutOfBus(false, 0);
+    const int numChannels = std::max(1, layout.size());
+    const auto pingPongRing = getPingPongRing(layout);
+
+    // Prepare the engine for the precision in use and free the other one
+    if (isUsingDoublePrecision() || offline)
+    {
+        dubDelayDouble.setRenderQuality(offline ? DubDelay<double>::RenderQuality::offline
+                                                : DubDelay<double>::RenderQuality::realtime);
+        dubDelayDouble.prepare(sampleRate, samplesPerBlock, numChannels);
+        dubDelayDouble.setPingPongRing(pingPongRing);
+        dubDelayFloat.release();
+        setLatencySamples(dubDelayDouble.getLatencySamples());
+        updateTailLength(dubDelayDouble);
+    }
+    else
+    {
+        dubDelayFloat.setRenderQuality(DubDelay<float>::RenderQuality::realtime);
+        dubDelayFloat.prepare(sampleRate, samplesPerBlock, numChannels);
+        dubDelayFloat.setPingPongRing(pingPongRing);
+        dubDelayDouble.release();
+        setLatencySamples(dubDelayFloat.getLatencySamples());
+        updateTailLength(dubDelayFloat);
+    }
+
+    if (floatHostOnDoubleEngine.load())
+        offlineBuffer.setSize(std::max(getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    else
+        offlineBuffer.setSize(0, 0);
+
+    engineNeedsParameters = true;         // The prepared engine may not have seen the current set
     needsResetOnNextProcess.store(true);  // Ensure clean start
 }
 
 void KingDubbyAudioProcessor::releaseResources()
 {
-    dubDelay.reset();
+    dubDelayFloat.reset();
+    dubDelayDouble.reset();
     needsResetOnNextProcess.store(true);  // Reset on next processBlock after resume
 }
 
@@ -191,11 +559,17 @@ void KingDubbyAudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buf
     juce::AudioProcessor::processBlockBypassed(buffer, midiMessages);
 }
 
+void KingDubbyAudioProcessor::processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    needsResetOnNextProcess.store(true);
+    juce::AudioProcessor::processBlockBypassed(buffer, midiMessages);
+}
+
 bool KingDubbyAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    // Support mono or stereo
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Mono, stereo or any layout up to DubDelay's channel count (quad, 5.1, 7.1, ...)
+    const auto& output = layouts.getMainOutputChannelSet();
+    if (output.isDisabled() || output.size() > DubDelay<float>::MAX_CHANNELS)
         return false;
 
     // Input must match output
@@ -206,8 +580,30 @@ bool KingDubbyAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts)
 }
 
 void KingDubbyAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& /*midiMessages*/)
+{
+    if (floatHostOnDoubleEngine.load(std::memory_order_relaxed))
+    {
+        // Offline render: widen, run the double engine, narrow back (only
+        // reallocates if the host exceeds the prepared block size)
+        offlineBuffer.makeCopyOf(buffer, true);
+        processBlockInternal(offlineBuffer, dubDelayDouble);
+        buffer.makeCopyOf(offlineBuffer, true);
+        return;
+    }
+
+    processBlockInternal(buffer, dubDelayFloat);
+}
+
+void KingDubbyAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& /*midiMessages*/)
+{
+    processBlockInternal(buffer, dubDelayDouble);
+}
+
+template <typename SampleType>
+void KingDubbyAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer, DubDelay<SampleType>& engine)
 {
     juce::ScopedNoDenormals noDenormals;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
 
     // Wall-clock gap detection (Ableton device on/off, see issue #16)
     // If >GAP_THRESHOLD_MS passed since last processBlock, we were suspended
@@ -237,29 +633,49 @@ void KingDubbyAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
                     || (isPlaying && !wasPlaying);
     wasPlaying = isPlaying;
 
+    // Update delay parameters - one snapshot per block, setters only when
+    // something (or the host tempo, which the synced taps depend on) moved
+    const bool parametersChanged = refreshParameters();
+    const ParameterSnapshot& params = blockParameters;
+
+    if (parametersChanged || engineNeedsParameters || bpm != lastAppliedBpm)
+    {
+        params.applyTo(engine, bpm);
+        engineNeedsParameters = false;
+        lastAppliedBpm = bpm;
+
+        tailLengthSeconds.store(roundUpTail(engine.getTailLengthSeconds()));
+
+        // New program: crossfade to its delay time instead of a long tape glide
+        if (params.programChanges != lastProgramChanges)
+        {
+            engine.crossfadeDelayTime();
+            lastProgramChanges = params.programChanges;
+        }
+    }
+
+    // Heavier tier while the host renders offline. The engine defers the
+    // switch to its next reset (or silence), so toggling here never glitches.
+    engine.setRenderQuality(isNonRealtime() ? DubDelay<SampleType>::RenderQuality::offline
+                                            : DubDelay<SampleType>::RenderQuality::realtime);
+
     if (shouldReset)
     {
-        dubDelay.reset();
-        buffer.clear();  // Output silence to prevent pop
+        // O(1) - stale delay lines are masked rather than cleared, and this
+        // block fades in instead of being replaced by silence (no pop)
+        engine.reset();
+        loadMonitor.recordReset();
         DBG("KingDubby: reset (wallClockGap=" + juce::String(wallClockGap ? 1 : 0)
             + " elapsed=" + juce::String(elapsed) + "ms)");
-        return;
     }
 
-    // Update delay parameters
-    dubDelay.setDelayTime(timeParam->load(), true, bpm);
-    dubDelay.setFeedback(feedbackParam->load());
-    dubDelay.setDegradation(degradParam->load());
-    dubDelay.setFilterType(filterTypeParam->load() > 0.5f);
-    dubDelay.setFilterFrequency(filterFreqParam->load());
-    dubDelay.setFilterBandwidth(filterBWParam->load());
-    dubDelay.setGain(gainParam->load());
-    dubDelay.setPanLR(panLRParam->load());
-    dubDelay.setPanRL(panRLParam->load());
-    dubDelay.setMix(mixParam->load());
-
     // Process audio
-    dubDelay.process(buffer);
+    engine.process(buffer);
+
+    // Time against the block's real-time budget (HUD stats)
+    loadMonitor.recordBlock(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks),
+                            buffer.getNumSamples(), getSampleRate(),
+                            static_cast<int>(engine.getLastEnginePath()));
 }
 
 bool KingDubbyAudioProcessor::hasEditor() const
@@ -274,19 +690,48 @@ juce::AudioProcessorEditor* KingDubbyAudioProcessor::createEditor()
 
 void KingDubbyAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Packed parameter values - no ValueTree or XML (see BinaryState.h)
+    binaryState->write(destData, currentProgram.load());
 }
 
 void KingDubbyAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+    if (! BinaryState::isBinaryState(data, sizeInBytes))
+    {
+        setXmlStateInformation(data, sizeInBytes);  // Saved by an older version
+        return;
+    }
+
+    // One snapshot for the whole state, like a program change (minus the
+    // crossfade); a program not yet in the parameters is superseded
+    int program = 0;
+    pendingProgram.store(-1);
+    parameterLoads.fetch_add(1);
+    const bool restored = binaryState->read(data, sizeInBytes, program);
+    parameterLoads.fetch_add(1);
+
+    if (restored)
+    {
+        if (program >= 0 && program < getNumPrograms())
+            currentProgram.store(program);
+        parameterEdits.fetch_add(1);
+        tailAnnouncePending.store(true);
+    }
+}
+
+void KingDubbyAudioProcessor::setXmlStateInformation(const void* data, int sizeInBytes)
 {
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState != nullptr)
     {
         if (xmlState->hasTagName(apvts.state.getType()))
         {
+            pendingProgram.store(-1);
+            parameterLoads.fetch_add(1);
             apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+            parameterLoads.fetch_add(1);
+            parameterEdits.fetch_add(1);
+            tailAnnouncePending.store(true);
         }
     }
 }
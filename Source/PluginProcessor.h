@@ -2,8 +2,15 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "DubDelay.h"
-
-class KingDubbyAudioProcessor : public juce::AudioProcessor
+#include "ParameterSnapshot.h"
+#include "TripleBuffer.h"
+#include "DspLoadMonitor.h"
+#include "FactoryPresets.h"
+#include "BinaryState.h"
+
+class KingDubbyAudioProcessor : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::Timer
 {
 public:
     KingDubbyAudioProcessor();
@@ -15,7 +22,12 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
     void processBlockBypassed(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    // 64-bit hosts get a native double engine (no conversion around the plugin)
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -39,6 +51,26 @@ public:
     // Parameter tree
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+    // DSP diagnostics (safe to poll from the message thread)
+    juce::uint32 getCoefficientUpdateCount() const
+    {
+        return dubDelayFloat.getCoefficientUpdateCount() + dubDelayDouble.getCoefficientUpdateCount();
+    }
+
+    // Per-block DSP load of this instance (read by the editor's performance HUD)
+    const DspLoadMonitor& getLoadMonitor() const { return loadMonitor; }
+
+    // True when the double engine is running (64-bit host, or an offline render)
+    bool isRunningDoubleEngine() const { return isUsingDoublePrecision() || floatHostOnDoubleEngine.load(); }
+
+    // Current parameter values as one set (the command-line renderer drives
+    // DubDelay with it directly)
+    ParameterSnapshot getParameterSnapshot() const;
+
+    // Moves a program picked by setCurrentProgram() into the parameters now
+    // (message thread; the timer does this on its next tick otherwise)
+    void updateProgramParameters();
+
     // Parameter IDs
     static const juce::String PARAM_TIME;
     static const juce::String PARAM_FEEDBACK;
@@ -50,14 +82,92 @@ public:
     static const juce::String PARAM_PAN_LR;
     static const juce::String PARAM_PAN_RL;
     static const juce::String PARAM_MIX;
+    static const juce::String PARAM_SAT_QUALITY;
+    static const juce::String PARAM_FILTER_TOPOLOGY;
+    static const juce::String PARAM_WOW_DEPTH;
+    static const juce::String PARAM_WOW_RATE;
+    static const juce::String PARAM_WOW_DRIFT;
+
+    // Extra delay taps 2..DubDelay::MAX_TAPS (tap 1 is TIME):
+    // "tap<N>Time" (1-96), "tap<N>Level" (0-100), "tap<N>Pan" (0-100)
+    static juce::String getTapParamID(int tapNumber, const juce::String& name);
+
+    // Channels PAN L->R / R->L ping-pong around: every channel of the layout
+    // but the LFE (in stereo: plain L <-> R)
+    static std::vector<int> getPingPongRing(const juce::AudioChannelSet& layout);
 
 private:
     juce::AudioProcessorValueTreeState apvts;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    DubDelay dubDelay;
-
-    // Atomic pointers to parameters
+    // One engine per processing precision; only the one in use is prepared.
+    // Offline renders (isNonRealtime() at prepareToPlay) put 32-bit hosts on
+    // the double engine too, converting through offlineBuffer.
+    DubDelay<float> dubDelayFloat;
+    DubDelay<double> dubDelayDouble;
+    std::atomic<bool> floatHostOnDoubleEngine { false };
+    juce::AudioBuffer<double> offlineBuffer;
+
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, DubDelay<SampleType>& engine);
+
+    // Parameter snapshot: a parameter change on any thread (UI, host
+    // automation, state restore) only bumps parameterEdits. The audio thread
+    // rebuilds its set from the parameter atomics at the top of the next
+    // block, so automation lands in the block it belongs to (offline bounces
+    // included). While no blocks run, the message thread's timer publishes
+    // the set through the TripleBuffer instead (its one writer). No locks on
+    // either side; the edit count in each set keeps an older one from
+    // replacing a newer one.
+    static constexpr int PUBLISH_INTERVAL_MS = 10;
+    TripleBuffer<ParameterSnapshot> parameterSnapshots;
+    DspLoadMonitor loadMonitor;
+    std::atomic<juce::uint32> parameterEdits { 0 };
+    std::atomic<juce::uint32> appliedEdits { 0 };   // Edits the audio thread's set reflects
+    juce::uint32 lastPublishedEdits = 0;            // Message thread
+    ParameterSnapshot blockParameters;              // Audio thread (and prepareToPlay())
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void timerCallback() override;
+    void publishParameters();
+    bool refreshParameters();
+    static bool isNewer(juce::uint32 edits, juce::uint32 than) noexcept { return static_cast<juce::int32>(edits - than) > 0; }
+
+    // Factory programs (FACTORY_PRESETS). setCurrentProgram() may run on the
+    // audio thread (VST3 program changes), so it only builds the preset's set
+    // and writes it to programSnapshots (its one writer) - the audio thread
+    // switches the whole set in the next block, with no reset, no lock, no
+    // allocation and no listener or host callback. The timer then moves the
+    // values into the parameters (pendingProgram); until it has, the
+    // parameter atomics are not snapshotted, so the old values can't come back.
+    std::atomic<int> currentProgram { 0 };
+    std::atomic<int> pendingProgram { -1 };              // Not yet in the parameters
+    std::atomic<juce::uint32> programChangeCount { 0 };
+    TripleBuffer<ParameterSnapshot> programSnapshots;
+    juce::uint32 lastProgramChanges = 0;        // Audio thread
+    void setProgramParameter(juce::RangedAudioParameter* parameter, float value);
+
+    // State restores write the parameters one by one inside a load window
+    // (parameterLoads odd) that no snapshot is taken in
+    std::atomic<juce::uint32> parameterLoads { 0 };      // Bumped at the start and end of a restore
+
+    bool engineNeedsParameters = true;          // Push the full set on the next block (after prepare)
+    double lastAppliedBpm = 0.0;
+
+    // Tail length: estimated in prepareToPlay() and again by the audio thread
+    // whenever it applies new settings (DubDelay::getTailLengthSeconds(),
+    // rounded up to TAIL_STEP_SECONDS). Infinite until the first estimate, so
+    // nothing is cut off before it.
+    // Announced to the host only after a program change or state restore
+    // (tailAnnouncePending), once the audio thread has the loaded set.
+    static constexpr double TAIL_STEP_SECONDS = 0.5;
+    std::atomic<double> tailLengthSeconds { std::numeric_limits<double>::infinity() };
+    std::atomic<bool> tailAnnouncePending { false };
+    void announceTailLength();
+    static double roundUpTail(double seconds) { return std::ceil(seconds / TAIL_STEP_SECONDS) * TAIL_STEP_SECONDS; }
+    template <typename SampleType>
+    void updateTailLength(DubDelay<SampleType>& engine);
+
+    // Atomic pointers to parameters (read by getParameterSnapshot())
     std::atomic<float>* timeParam = nullptr;
     std::atomic<float>* feedbackParam = nullptr;
     std::atomic<float>* degradParam = nullptr;
@@ -68,6 +178,24 @@ private:
     std::atomic<float>* panLRParam = nullptr;
     std::atomic<float>* panRLParam = nullptr;
     std::atomic<float>* mixParam = nullptr;
+    std::atomic<float>* satQualityParam = nullptr;
+    std::atomic<float>* filterTopologyParam = nullptr;
+    std::atomic<float>* wowDepthParam = nullptr;
+    std::atomic<float>* wowRateParam = nullptr;
+    std::atomic<float>* wowDriftParam = nullptr;
+
+    struct TapParams
+    {
+        std::atomic<float>* time = nullptr;
+        std::atomic<float>* level = nullptr;
+        std::atomic<float>* pan = nullptr;
+        juce::RangedAudioParameter* levelParameter = nullptr;  // Programs switch taps off
+    };
+    std::array<TapParams, DubDelay<float>::MAX_TAPS - 1> tapParams;
+
+    // Session state: packed binary (XML states from older versions still load)
+    std::unique_ptr<BinaryState> binaryState;
+    void setXmlStateInformation(const void* data, int sizeInBytes);
 
     // State tracking for buffer clearing
     bool wasPlaying = false;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * TripleBuffer - lock-free single-reader handoff of a whole value
+ *
+ * The writer fills a private back slot and swaps it with the shared middle
+ * slot; the reader swaps the middle slot for its front slot only when a new
+ * value has been published since its last read. Neither side ever waits or
+ * sees a half-written value, and the reader learns for free whether anything
+ * changed.
+ *
+ * One writer at a time (callers on several threads must serialise write()),
+ * one reader (the audio thread).
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Publish a new value (replaces any value the reader hasn't picked up yet)
+    void write(const T& value) noexcept
+    {
+        slots[static_cast<size_t>(backIndex)] = value;
+        backIndex = middle.exchange(backIndex | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Latest published value; changed is set when it differs from the last read
+    const T& read(bool& changed) noexcept
+    {
+        changed = (middle.load(std::memory_order_relaxed) & DIRTY) != 0;
+
+        if (changed)
+            frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+
+        return slots[static_cast<size_t>(frontIndex)];
+    }
+
+private:
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int DIRTY = 4;
+
+    std::array<T, 3> slots {};
+    int frontIndex = 0;                 // Reader only
+    int backIndex = 1;                  // Writer only
+    std::atomic<int> middle { 2 };      // Shared slot index | DIRTY
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cmath>
+
+/**
+ * WowFlutter - PT2399 clock instability as a delay-time modulator
+ *
+ * The PT2399's delay is a clock count, so a wandering VCO stretches every
+ * delay by the same relative amount. This produces that relative deviation
+ * (delay * (1 + deviation)): a slow wow LFO, a faster flutter LFO and an
+ * optional filtered random drift, all scaled by DEPTH.
+ *
+ * The modulation is evaluated at a control rate (every CONTROL_INTERVAL
+ * samples) from a shared sine wavetable and linearly interpolated in
+ * between. DEPTH is smoothed at the control rate so turning it up glides
+ * the pitch in rather than jumping the read position. Once DEPTH is 0 and the
+ * last ramp has reached 0, isActive() goes false and DubDelay skips the
+ * section entirely.
+ */
+class WowFlutter
+{
+public:
+    static constexpr int CONTROL_INTERVAL = 32;             // Samples per control point
+
+    // Peak relative deviation of each component at DEPTH 100
+    static constexpr float WOW_DEVIATION = 0.006f;
+    static constexpr float FLUTTER_DEVIATION = 0.0004f;
+    static constexpr float DRIFT_DEVIATION = 0.004f;
+    static constexpr float MAX_DEVIATION = WOW_DEVIATION + FLUTTER_DEVIATION + DRIFT_DEVIATION;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        controlRate = sampleRate / CONTROL_INTERVAL;
+        depthCoefficient = static_cast<float>(std::exp(-1.0 / (DEPTH_SMOOTHING_SECONDS * controlRate)));
+        updateIncrements();
+        reset();
+    }
+
+    // Back to rest (no deviation) with a fresh, repeatable drift sequence
+    void reset()
+    {
+        current = target = step = 0.0f;
+        samplesToControl = 0;
+        smoothedDepth = 0.0f;
+        wowPhase = flutterPhase = 0.0f;
+        drift = driftTarget = 0.0f;
+        driftTicksRemaining = 0;
+        randomState = RANDOM_SEED;
+    }
+
+    void setDepth(float newDepth) { depth = newDepth / 100.0f; }   // 0-100
+    void setDrift(float newDrift) { driftAmount = newDrift / 100.0f; }  // 0-100
+
+    void setRate(float newRate)                                    // 0-100
+    {
+        if (newRate == rate)
+            return;
+
+        rate = newRate;
+        updateIncrements();
+    }
+
+    bool isActive() const noexcept { return depth > 0.0f || current != 0.0f || target != 0.0f; }
+
+    // Relative clock deviation for the next numSamples samples
+    void process(float* deviation, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (samplesToControl == 0)
+            {
+                current = target;
+                target = nextControlValue();
+                step = (target - current) / static_cast<float>(CONTROL_INTERVAL);
+                samplesToControl = CONTROL_INTERVAL;
+            }
+
+            // Land exactly on the control point (no accumulated ramp error)
+            current = --samplesToControl == 0 ? target : current + step;
+            deviation[i] = current;
+        }
+    }
+
+private:
+    static constexpr int SINE_TABLE_SIZE = 512;
+    static constexpr float DEPTH_SMOOTHING_SECONDS = 0.2f;
+    static constexpr juce::uint32 RANDOM_SEED = 0x2399u;
+
+    // One cycle of sine plus a guard point, shared by every instance
+    static const std::array<float, SINE_TABLE_SIZE + 1>& getSineTable()
+    {
+        static const auto table = []
+        {
+            std::array<float, SINE_TABLE_SIZE + 1> t {};
+            for (int i = 0; i <= SINE_TABLE_SIZE; ++i)
+                t[static_cast<size_t>(i)] = static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * i / SINE_TABLE_SIZE));
+            return t;
+        }();
+
+        return table;
+    }
+
+    static float sine(float phase) noexcept
+    {
+        const auto& table = getSineTable();
+        const float position = phase * static_cast<float>(SINE_TABLE_SIZE);
+        const auto index = static_cast<size_t>(position);
+        const float fraction = position - static_cast<float>(index);
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+    static float advance(float phase, float increment) noexcept
+    {
+        phase += increment;
+        return phase >= 1.0f ? phase - 1.0f : phase;
+    }
+
+    // xorshift32 -> [-1, 1)
+    float nextRandom() noexcept
+    {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return static_cast<float>(randomState) * (2.0f / 4294967296.0f) - 1.0f;
+    }
+
+    float nextControlValue() noexcept
+    {
+        smoothedDepth = depth + (smoothedDepth - depth) * depthCoefficient;
+
+        wowPhase = advance(wowPhase, wowIncrement);
+        flutterPhase = advance(flutterPhase, flutterIncrement);
+
+        // Drift: hold a random target, glide towards it, pick the next one
+        if (--driftTicksRemaining <= 0)
+        {
+            driftTarget = nextRandom();
+            driftTicksRemaining = driftHoldTicks;
+        }
+        drift += (driftTarget - drift) * driftCoefficient;
+
+        const float value = WOW_DEVIATION * sine(wowPhase)
+                          + FLUTTER_DEVIATION * sine(flutterPhase)
+                          + DRIFT_DEVIATION * driftAmount * drift;
+
+        // Snap the tail of the depth glide so the section can switch off
+        return smoothedDepth < 1.0e-4f && depth == 0.0f ? 0.0f : smoothedDepth * value;
+    }
+
+    void updateIncrements()
+    {
+        // RATE 0-100: wow 0.1-2.5 Hz, flutter 4-14 Hz, drift moves every 2-0.25 s
+        const float amount = rate / 100.0f;
+        const double wowHz = juce::jmap(amount, 0.1f, 2.5f);
+        const double flutterHz = juce::jmap(amount, 4.0f, 14.0f);
+        const double driftSeconds = juce::jmap(amount, 2.0f, 0.25f);
+
+        wowIncrement = static_cast<float>(wowHz / controlRate);
+        flutterIncrement = static_cast<float>(flutterHz / controlRate);
+        driftHoldTicks = std::max(1, static_cast<int>(driftSeconds * controlRate));
+        driftCoefficient = static_cast<float>(1.0 - std::exp(-2.0 / (driftSeconds * controlRate)));
+    }
+
+    double sampleRate = 44100.0;
+    double controlRate = 44100.0 / CONTROL_INTERVAL;
+
+    // Settings
+    float depth = 0.0f;
+    float rate = 50.0f;
+    float driftAmount = 0.0f;
+
+    // Control-rate state
+    float current = 0.0f, target = 0.0f, step = 0.0f;
+    int samplesToControl = 0;
+    float smoothedDepth = 0.0f;
+    float depthCoefficient = 0.0f;
+    float wowPhase = 0.0f, wowIncrement = 0.0f;
+    float flutterPhase = 0.0f, flutterIncrement = 0.0f;
+    float drift = 0.0f, driftTarget = 0.0f, driftCoefficient = 0.0f;
+    int driftTicksRemaining = 0, driftHoldTicks = 1;
+    juce::uint32 randomState = RANDOM_SEED;
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "../../../Source/BandpassBank.h"
+#include "../../../Source/CoefficientTables.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/**
+ * BandpassResponseCheck - BandpassBank against the bandpass it replaced
+ *
+ * The feedback bandpass used to be one (12 dB) or two (24 dB) cascaded
+ * juce::dsp::StateVariableTPTFilter bandpass stages. This renders impulse
+ * responses of that cascade and of both BandpassBank topologies (SVF and
+ * cookbook biquad) over 44.1-192 kHz, FREQ 300-3000 Hz, BANDW 0-4 and
+ * 12/24 dB, in float and double, and compares magnitude responses (Goertzel
+ * at log-spaced frequencies) wherever the old filter is above FLOOR_DB.
+ *
+ * Tolerances: float FLOAT_TOLERANCE_DB (the biquad's coefficient rounding;
+ * the SVF matches far closer), double DOUBLE_TOLERANCE_DB.
+ */
+struct BandpassResponseCheck
+{
+    static constexpr double FLOOR_DB = -40.0;
+    static constexpr double FLOAT_TOLERANCE_DB = 0.11;
+    static constexpr double DOUBLE_TOLERANCE_DB = 1.0e-4;
+    static constexpr double IMPULSE_SECONDS = 0.2;   // Q 5 at 300 Hz, 24 dB rings out well inside this
+    static constexpr int NUM_FREQUENCIES = 48;
+    static constexpr double LOWEST_HZ = 20.0;
+    static constexpr double HIGHEST_HZ = 20000.0;
+
+    static int run(const juce::ArgumentList&)
+    {
+        const int failures = check<float>("float", FLOAT_TOLERANCE_DB) + check<double>("double", DOUBLE_TOLERANCE_DB);
+        std::cout << (failures == 0 ? "BandpassBank ok\n" : "BandpassBank FAILED\n");
+        return failures == 0 ? 0 : 1;
+    }
+
+private:
+    using Topology = BandpassBank<float>::Topology;
+
+    template <typename SampleType>
+    static int check(const char* precision, double tolerance)
+    {
+        const Topology topologies[] = { Topology::svf, Topology::biquad };
+        double worst[2] = {};
+        juce::String worstCase[2];
+
+        for (const double sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+        {
+            const CoefficientTables tables(sampleRate);
+            const auto length = static_cast<int>(IMPULSE_SECONDS * sampleRate);
+
+            for (const float frequency : { 300.0f, 550.0f, 1000.0f, 1800.0f, 3000.0f })
+                for (const float bandwidth : { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f })
+                    for (const bool filter24dB : { false, true })
+                    {
+                        const auto reference = magnitudesDb(referenceImpulse<SampleType>(sampleRate, length, frequency,
+                                                                                         bandwidth, filter24dB),
+                                                            sampleRate);
+
+                        for (size_t t = 0; t < 2; ++t)
+                        {
+                            const auto bank = magnitudesDb(bankImpulse<SampleType>(tables, length, topologies[t], frequency,
+                                                                                   bandwidth, filter24dB),
+                                                           sampleRate);
+
+                            for (size_t k = 0; k < reference.size(); ++k)
+                            {
+                                if (reference[k] < FLOOR_DB)
+                                    continue;
+
+                                const double deviation = std::abs(bank[k] - reference[k]);
+                                if (deviation > worst[t])
+                                {
+                                    worst[t] = deviation;
+                                    worstCase[t] = juce::String(static_cast<int>(sampleRate)) + " Hz, FREQ "
+                                                 + juce::String(frequency, 0) + ", BANDW " + juce::String(bandwidth, 1)
+                                                 + (filter24dB ? ", 24 dB" : ", 12 dB") + " at "
+                                                 + juce::String(frequencyAt(k), 1) + " Hz";
+                                }
+                            }
+                        }
+                    }
+        }
+
+        int failures = 0;
+        for (size_t t = 0; t < 2; ++t)
+        {
+            const bool ok = worst[t] <= tolerance;
+            std::cout << (ok ? "ok   " : "FAIL ") << precision << (topologies[t] == Topology::svf ? "/svf" : "/biquad")
+                      << ": max deviation " << worst[t] << " dB (tolerance " << tolerance << " dB)";
+            if (worst[t] > 0.0)
+                std::cout << ", " << worstCase[t];
+            std::cout << "\n";
+
+            if (! ok)
+                ++failures;
+        }
+
+        return failures;
+    }
+
+    // The old chain: one StateVariableTPTFilter bandpass per stage
+    template <typename SampleType>
+    static std::vector<SampleType> referenceImpulse(double sampleRate, int length, float frequency, float bandwidth, bool filter24dB)
+    {
+        juce::dsp::StateVariableTPTFilter<SampleType> stages[2];
+        for (auto& stage : stages)
+        {
+            stage.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+            stage.prepare({ sampleRate, static_cast<juce::uint32>(length), 1 });
+            stage.setCutoffFrequency(static_cast<SampleType>(frequency));
+            stage.setResonance(static_cast<SampleType>(CoefficientTables::bandwidthToResonance(bandwidth)));
+        }
+
+        std::vector<SampleType> response(static_cast<size_t>(length));
+        for (size_t i = 0; i < response.size(); ++i)
+        {
+            SampleType y = stages[0].processSample(0, i == 0 ? SampleType(1) : SampleType(0));
+            if (filter24dB)
+                y = stages[1].processSample(0, y);
+            response[i] = y;
+        }
+
+        return response;
+    }
+
+    template <typename SampleType>
+    static std::vector<SampleType> bankImpulse(const CoefficientTables& tables, int length, Topology topology,
+                                               float frequency, float bandwidth, bool filter24dB)
+    {
+        using Lanes = juce::dsp::SIMDRegister<SampleType>;
+
+        BandpassBank<SampleType> bank;
+        bank.setTopology(static_cast<typename BandpassBank<SampleType>::Topology>(topology));
+        bank.setPrewarpedCutoff(tables.prewarp(frequency));
+        bank.setDamping(tables.damping(bandwidth));
+        bank.reset();
+
+        std::vector<Lanes> frames(static_cast<size_t>(length), Lanes (SampleType(0)));
+        frames[0] = Lanes (SampleType(1));
+
+        if (filter24dB)
+            bank.template process<true>(frames.data(), length);
+        else
+            bank.template process<false>(frames.data(), length);
+
+        std::vector<SampleType> response(frames.size());
+        for (size_t i = 0; i < frames.size(); ++i)
+            response[i] = frames[i].get(0);
+
+        return response;
+    }
+
+    static double frequencyAt(size_t k)
+    {
+        return LOWEST_HZ * std::pow(HIGHEST_HZ / LOWEST_HZ, static_cast<double>(k) / (NUM_FREQUENCIES - 1));
+    }
+
+    // |H| in dB at the check frequencies (Goertzel over the impulse response);
+    // frequencies at or above 0.45 fs are skipped (-inf)
+    template <typename SampleType>
+    static std::vector<double> magnitudesDb(const std::vector<SampleType>& impulse, double sampleRate)
+    {
+        std::vector<double> result(NUM_FREQUENCIES, -std::numeric_limits<double>::infinity());
+
+        for (size_t k = 0; k < result.size(); ++k)
+        {
+            const double frequency = frequencyAt(k);
+            if (frequency >= 0.45 * sampleRate)
+                continue;
+
+            const double w = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+            const double coefficient = 2.0 * std::cos(w);
+            double s1 = 0.0, s2 = 0.0;
+            for (const auto x : impulse)
+            {
+                const double s0 = static_cast<double>(x) + coefficient * s1 - s2;
+                s2 = s1;
+                s1 = s0;
+            }
+
+            const double re = s1 - s2 * std::cos(w);
+            const double im = s2 * std::sin(w);
+            result[k] = 20.0 * std::log10(std::max(std::sqrt(re * re + im * im), 1.0e-30));
+        }
+
+        return result;
+    }
+};
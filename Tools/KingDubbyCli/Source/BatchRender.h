@@ -0,0 +1,425 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "../../../Source/PluginProcessor.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * BatchRender - renders audio files through DubDelay, tail included
+ *
+ * The parameter set is resolved once, on the message thread, through a
+ * KingDubbyAudioProcessor (factory program or saved state, then per-ID
+ * overrides) and handed to every job as a ParameterSnapshot. Each file then
+ * gets its own DubDelay:
+ * - input through a MemoryMappedAudioFormatReader (WAV/AIFF), so the file
+ *   is paged in as it is read rather than loaded up front; mono up to 7.1,
+ *   ping-pong around every channel of the file's layout but the LFE
+ * - processed and written to a WAV writer one block at a time
+ * - followed by silence until the engine goes to sleep (tail below
+ *   -100 dBFS) or --max-tail runs out
+ *
+ * Files are spread over a WorkStealingPool, longest first. A render only
+ * depends on its file and the settings (fixed wow/flutter seed, denormals
+ * flushed on every worker), so the output is bit-identical whatever the
+ * thread count; --verify proves it by rendering every file again on the
+ * calling thread and comparing sample hashes.
+ *
+ * Default is the plugin's offline tier (double engine, windowed-sinc reads,
+ * 4x oversampled saturation); --realtime renders what a float host plays.
+ */
+class BatchRender
+{
+public:
+    struct Settings
+    {
+        ParameterSnapshot parameters;
+        double bpm = 120.0;
+        int blockSize = 512;
+        bool realtime = false;          // Float engine, realtime tier
+        double maxTailSeconds = 30.0;
+        int bitsPerSample = 24;
+        juce::File outputDirectory;     // Next to each input when not set
+    };
+
+    struct Result
+    {
+        juce::String error;             // Empty on success
+        double inputSeconds = 0.0;
+        double tailSeconds = 0.0;
+        bool tailCapped = false;        // Still ringing at --max-tail
+        double renderSeconds = 0.0;     // Wall clock
+        juce::uint64 hash = 0;          // FNV-1a of the rendered samples
+    };
+
+    static int run(const juce::ArgumentList& args)
+    {
+        Settings settings;
+        juce::String error;
+        if (! parseSettings(args, settings, error))
+        {
+            std::cerr << error << "\n";
+            return 1;
+        }
+
+        juce::Array<juce::File> inputs;
+        for (const auto& argument : args.arguments)
+            if (! argument.isOption())
+                inputs.add(argument.resolveAsExistingFile());
+
+        if (inputs.isEmpty())
+        {
+            std::cerr << "No input files\n";
+            return 1;
+        }
+
+        // Two inputs rendering to the same file (same name from different
+        // folders with --out), or an output overwriting an input, would race
+        if (! checkOutputFiles(inputs, settings))
+            return 1;
+
+        // Longest first, so the pool's owners start on the big jobs
+        std::sort(inputs.begin(), inputs.end(),
+                  [] (const juce::File& a, const juce::File& b) { return a.getSize() > b.getSize(); });
+
+        const int threads = args.containsOption("--threads")
+                          ? juce::jmax(1, args.getValueForOption("--threads").getIntValue())
+                          : juce::jmin(inputs.size(), static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+
+        std::vector<Result> results(static_cast<size_t>(inputs.size()));
+        std::mutex printLock;
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        WorkStealingPool(threads).run(inputs.size(), [&] (int job, int)
+        {
+            const auto& input = inputs.getReference(job);
+            auto& result = results[static_cast<size_t>(job)];
+            result = renderFile(input, getOutputFile(input, settings), settings);
+
+            const std::lock_guard<std::mutex> guard(printLock);
+            printResult(input, result);
+        });
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+
+        double audioSeconds = 0.0;
+        int failed = 0;
+        for (const auto& result : results)
+        {
+            audioSeconds += result.inputSeconds + result.tailSeconds;
+            failed += result.error.isNotEmpty() ? 1 : 0;
+        }
+
+        std::cout << "\n" << inputs.size() - failed << " of " << inputs.size() << " files, "
+                  << juce::String(audioSeconds, 1) << " s of audio in " << juce::String(wallSeconds, 2)
+                  << " s on " << threads << " threads: " << juce::String(audioSeconds / wallSeconds, 1)
+                  << "x realtime\n";
+
+        if (args.containsOption("--verify") && ! verify(inputs, results, settings))
+            return 1;
+
+        return failed == 0 ? 0 : 1;
+    }
+
+    // One file, start to end of tail. output may be juce::File() to render
+    // without writing (hash only).
+    static Result renderFile(const juce::File& input, const juce::File& output, const Settings& settings)
+    {
+        return settings.realtime ? render<float>(input, output, settings)
+                                 : render<double>(input, output, settings);
+    }
+
+private:
+    template <typename SampleType>
+    static Result render(const juce::File& input, const juce::File& output, const Settings& settings)
+    {
+        // Same float environment on every thread (and as the plugin's audio thread)
+        juce::ScopedNoDenormals noDenormals;
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        Result result;
+
+        auto reader = openMapped(input, result.error);
+        if (reader == nullptr)
+            return result;
+
+        const int numChannels = static_cast<int>(reader->numChannels);
+        if (numChannels < 1 || numChannels > DubDelay<SampleType>::MAX_CHANNELS)
+        {
+            result.error = "1 to " + juce::String(DubDelay<SampleType>::MAX_CHANNELS) + " channels only";
+            return result;
+        }
+
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (output != juce::File())
+        {
+            // FileOutputStream appends to an existing file
+            std::unique_ptr<juce::FileOutputStream> file;
+            if (output.deleteFile())
+                file = std::make_unique<juce::FileOutputStream>(output);
+
+            if (file == nullptr || ! file->openedOk())
+            {
+                result.error = "can't write " + output.getFullPathName();
+                return result;
+            }
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::OutputStream> stream = std::move(file);
+            writer = wav.createWriterFor(stream, juce::AudioFormatWriterOptions {}
+                                                     .withSampleRate(reader->sampleRate)
+                                                     .withNumChannels(numChannels)
+                                                     .withBitsPerSample(settings.bitsPerSample));
+            if (writer == nullptr)
+            {
+                result.error = "can't create a WAV writer";
+                return result;
+            }
+        }
+
+        // Engine as the processor sets it up (ring from the file's layout, LFE
+        // left out), but landing on the delay time instead of gliding there
+        // from the default, and without the fade-in that covers a reset in a
+        // running stream
+        DubDelay<SampleType> engine;
+        engine.setRenderQuality(settings.realtime ? DubDelay<SampleType>::RenderQuality::realtime
+                                                  : DubDelay<SampleType>::RenderQuality::offline);
+        engine.prepare(reader->sampleRate, settings.blockSize, numChannels);
+        engine.setPingPongRing(KingDubbyAudioProcessor::getPingPongRing(reader->getChannelLayout()));
+        settings.parameters.applyTo(engine, settings.bpm);
+        engine.crossfadeDelayTime();
+        engine.skipResetFade();
+
+        juce::AudioBuffer<float> io(numChannels, settings.blockSize);
+        juce::AudioBuffer<SampleType> block(numChannels, settings.blockSize);
+        juce::uint64 hash = 14695981039346656037ull;
+
+        const auto inputLength = reader->lengthInSamples;
+        const auto maxTail = static_cast<juce::int64>(settings.maxTailSeconds * reader->sampleRate);
+        juce::int64 position = 0;
+
+        for (;;)
+        {
+            const bool inTail = position >= inputLength;
+            if (inTail && (engine.isSleeping() || position - inputLength >= maxTail))
+                break;
+
+            const int numSamples = static_cast<int>(inTail ? std::min<juce::int64>(settings.blockSize, inputLength + maxTail - position)
+                                                           : std::min<juce::int64>(settings.blockSize, inputLength - position));
+
+            io.setSize(numChannels, numSamples, false, false, true);
+            if (inTail)
+                io.clear();
+            else
+                reader->read(&io, 0, numSamples, position, true, numChannels > 1);
+
+            block.setSize(numChannels, numSamples, false, false, true);
+            copy(io, block);
+            engine.process(block);
+            copy(block, io);
+
+            hash = hashSamples(io, hash);
+            if (writer != nullptr && ! writer->writeFromAudioSampleBuffer(io, 0, numSamples))
+            {
+                result.error = "write failed";
+                return result;
+            }
+
+            position += numSamples;
+        }
+
+        result.inputSeconds = static_cast<double>(inputLength) / reader->sampleRate;
+        result.tailSeconds = static_cast<double>(position - inputLength) / reader->sampleRate;
+        result.tailCapped = ! engine.isSleeping();
+        result.hash = hash;
+        result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+        return result;
+    }
+
+    static std::unique_ptr<juce::MemoryMappedAudioFormatReader> openMapped(const juce::File& input, juce::String& error)
+    {
+        std::unique_ptr<juce::AudioFormat> format;
+        if (input.hasFileExtension("wav;bwf"))
+            format = std::make_unique<juce::WavAudioFormat>();
+        else if (input.hasFileExtension("aif;aiff"))
+            format = std::make_unique<juce::AiffAudioFormat>();
+        else
+        {
+            error = "WAV or AIFF input only";
+            return nullptr;
+        }
+
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(format->createMemoryMappedReader(input));
+        if (reader == nullptr || ! reader->mapEntireFile())
+        {
+            error = "can't map " + input.getFullPathName();
+            return nullptr;
+        }
+
+        return reader;
+    }
+
+    template <typename Source, typename Destination>
+    static void copy(const juce::AudioBuffer<Source>& source, juce::AudioBuffer<Destination>& destination)
+    {
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+        {
+            const auto* in = source.getReadPointer(channel);
+            auto* out = destination.getWritePointer(channel);
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                out[i] = static_cast<Destination>(in[i]);
+        }
+    }
+
+    // FNV-1a over the bits of what goes to the writer
+    static juce::uint64 hashSamples(const juce::AudioBuffer<float>& buffer, juce::uint64 hash)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            const auto* bytes = reinterpret_cast<const juce::uint8*>(buffer.getReadPointer(channel));
+            for (size_t i = 0; i < static_cast<size_t>(buffer.getNumSamples()) * sizeof(float); ++i)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Renders everything again on this thread and compares with the pool's output
+    static bool verify(const juce::Array<juce::File>& inputs, const std::vector<Result>& results, const Settings& settings)
+    {
+        int mismatches = 0;
+        for (int i = 0; i < inputs.size(); ++i)
+        {
+            const auto& pooled = results[static_cast<size_t>(i)];
+            if (pooled.error.isNotEmpty())
+                continue;
+
+            if (renderFile(inputs.getReference(i), juce::File(), settings).hash != pooled.hash)
+            {
+                std::cerr << "MISMATCH " << inputs.getReference(i).getFileName() << "\n";
+                ++mismatches;
+            }
+        }
+
+        std::cout << "verify: " << (mismatches == 0 ? juce::String("bit-identical to the single-threaded render")
+                                                    : juce::String(mismatches) + " files differ") << "\n";
+        return mismatches == 0;
+    }
+
+    static void printResult(const juce::File& input, const Result& result)
+    {
+        if (result.error.isNotEmpty())
+        {
+            std::cerr << input.getFileName() << ": " << result.error << "\n";
+            return;
+        }
+
+        std::cout << input.getFileName() << ": " << juce::String(result.inputSeconds, 1) << " s + "
+                  << juce::String(result.tailSeconds, 1) << " s tail" << (result.tailCapped ? " (capped)" : "")
+                  << ", " << juce::String((result.inputSeconds + result.tailSeconds) / result.renderSeconds, 1)
+                  << "x realtime\n";
+    }
+
+    static juce::File getOutputFile(const juce::File& input, const Settings& settings)
+    {
+        const auto directory = settings.outputDirectory != juce::File() ? settings.outputDirectory
+                                                                        : input.getParentDirectory();
+        return directory.getChildFile(input.getFileNameWithoutExtension() + "_dub.wav");
+    }
+
+    static bool checkOutputFiles(const juce::Array<juce::File>& inputs, const Settings& settings)
+    {
+        bool ok = true;
+        for (int i = 0; i < inputs.size(); ++i)
+        {
+            const auto output = getOutputFile(inputs.getReference(i), settings);
+            for (int j = 0; j < inputs.size(); ++j)
+            {
+                if (output == inputs.getReference(j))
+                {
+                    std::cerr << inputs.getReference(i).getFullPathName() << ": output would overwrite input "
+                              << inputs.getReference(j).getFullPathName() << "\n";
+                    ok = false;
+                }
+                else if (j > i && output == getOutputFile(inputs.getReference(j), settings))
+                {
+                    std::cerr << inputs.getReference(i).getFullPathName() << " and " << inputs.getReference(j).getFullPathName()
+                              << " both render to " << output.getFullPathName() << "\n";
+                    ok = false;
+                }
+            }
+        }
+        return ok;
+    }
+
+    static bool parseSettings(const juce::ArgumentList& args, Settings& settings, juce::String& error)
+    {
+        // Parameters through a processor: same IDs, ranges, programs and state format as the plugin
+        KingDubbyAudioProcessor processor;
+
+        if (args.containsOption("--state"))
+        {
+            juce::MemoryBlock state;
+            const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--state"));
+            if (! file.loadFileAsData(state))
+            {
+                error = "can't read " + file.getFullPathName();
+                return false;
+            }
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        }
+        else if (args.containsOption("--preset"))
+        {
+            const auto name = args.getValueForOption("--preset");
+            int program = -1;
+            for (int i = 0; i < processor.getNumPrograms(); ++i)
+                if (processor.getProgramName(i).equalsIgnoreCase(name) || name == juce::String(i))
+                    program = i;
+
+            if (program < 0)
+            {
+                error = "unknown preset " + name;
+                return false;
+            }
+            processor.setCurrentProgram(program);
+            processor.updateProgramParameters();   // No message loop to do it here
+        }
+
+        // --set=feedback=80,time=12 (parameter IDs, plain values)
+        for (const auto& assignment : juce::StringArray::fromTokens(args.getValueForOption("--set"), ",", ""))
+        {
+            auto* parameter = processor.getAPVTS().getParameter(assignment.upToFirstOccurrenceOf("=", false, false).trim());
+            if (parameter == nullptr || ! assignment.contains("="))
+            {
+                error = "bad --set entry " + assignment;
+                return false;
+            }
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(assignment.fromFirstOccurrenceOf("=", false, false).getFloatValue()));
+        }
+
+        settings.parameters = processor.getParameterSnapshot();
+        settings.realtime = args.containsOption("--realtime");
+
+        if (args.containsOption("--bpm"))
+            settings.bpm = juce::jlimit(20.0, 999.0, args.getValueForOption("--bpm").getDoubleValue());
+        if (args.containsOption("--block"))
+            settings.blockSize = juce::jlimit(16, 65536, args.getValueForOption("--block").getIntValue());
+        if (args.containsOption("--max-tail"))
+            settings.maxTailSeconds = juce::jmax(0.0, args.getValueForOption("--max-tail").getDoubleValue());
+        if (args.containsOption("--bits"))
+            settings.bitsPerSample = args.getValueForOption("--bits").getIntValue() == 16 ? 16 : 24;
+        if (args.containsOption("--out"))
+        {
+            settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+            if (! settings.outputDirectory.createDirectory().wasOk())
+            {
+                error = "can't create " + settings.outputDirectory.getFullPathName();
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
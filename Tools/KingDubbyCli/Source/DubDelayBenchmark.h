@@ -0,0 +1,381 @@
+#pragma once
+
+#include "../../../Source/DubDelay.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+/**
+ * DubDelayBenchmark - ns/sample for the engine and its hot kernels
+ *
+ * Times DubDelay::process() over a grid of sample rates, block sizes,
+ * mono/stereo/7.1, 12/24 dB, degradation off/on and a short vs long delay,
+ * then readDelay() (Catmull-Rom and the offline tier's windowed sinc), the
+ * settled-delay readSettled() (integer and fractional FixedTap) and
+ * softClip() on their own.
+ *
+ * Every case is the best of REPETITIONS runs over at least MIN_SECONDS of
+ * wall clock, on -20 dBFS noise so the engine never sleeps. Results go to
+ * JSON (--out); --baseline compares against an earlier file and fails the
+ * command when a case got slower than --tolerance percent. Compare runs
+ * from the same machine and build type only.
+ *
+ * The short delay is half a block (at most SHORT_DELAY_MS), so its reads
+ * land in the block being written and the per-sample engine runs - except
+ * where the 1 ms minimum delay is still longer than the block (blocks of 1
+ * and 16, 64 above 48 kHz). Every process case is named after the engine
+ * it actually dispatched to (/staged or /perSample).
+ */
+struct DubDelayBenchmark
+{
+    static constexpr int FORMAT_VERSION = 2;    // 2: short delay per block size, engine in the name
+    static constexpr int REPETITIONS = 5;
+    static constexpr double MIN_SECONDS = 0.02;
+    static constexpr float SHORT_DELAY_MS = 5.0f;
+    static constexpr float LONG_DELAY_MS = 750.0f;
+
+    struct Result
+    {
+        juce::String name;
+        double nsPerSample;
+    };
+
+    static int run(const juce::ArgumentList& args)
+    {
+        const bool useDouble = args.containsOption("--double");
+        const bool offline = args.containsOption("--offline");
+        const bool quick = args.containsOption("--quick");
+
+        auto results = useDouble ? runAll<double>(offline, quick) : runAll<float>(offline, quick);
+
+        const auto json = toJson(results, useDouble, offline);
+        if (args.containsOption("--out"))
+        {
+            const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+            if (! file.replaceWithText(json))
+            {
+                std::cerr << "can't write " << file.getFullPathName() << "\n";
+                return 1;
+            }
+        }
+
+        if (! args.containsOption("--baseline"))
+            return 0;
+
+        const auto tolerance = args.containsOption("--tolerance")
+                             ? args.getValueForOption("--tolerance").getDoubleValue() : 10.0;
+        const auto baseline = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--baseline"));
+        return compare(results, juce::JSON::parse(baseline.loadFileAsString()), tolerance, useDouble, offline) ? 0 : 1;
+    }
+
+    template <typename SampleType>
+    static std::vector<Result> runAll(bool offline, bool quick)
+    {
+        const std::vector<double> sampleRates = quick ? std::vector<double> { 48000.0 }
+                                                      : std::vector<double> { 44100.0, 48000.0, 96000.0, 192000.0 };
+        const std::vector<int> blockSizes = quick ? std::vector<int> { 64, 512 }
+                                                  : std::vector<int> { 1, 16, 64, 256, 1024, 4096 };
+        std::vector<Result> results;
+
+        for (auto sampleRate : sampleRates)
+            for (auto blockSize : blockSizes)
+                for (int channels : { 1, 2, 8 })
+                    for (bool filter24dB : { false, true })
+                        for (bool degrade : { false, true })
+                            for (bool longDelay : { false, true })
+                            {
+                                bool perSample = false;
+                                const double ns = timeProcess<SampleType>(sampleRate, blockSize, channels, filter24dB,
+                                                                          degrade, longDelay, offline, perSample);
+
+                                const auto name = "process/" + juce::String(static_cast<int>(sampleRate))
+                                                + "/b" + juce::String(blockSize)
+                                                + (channels == 1 ? "/mono" : channels == 2 ? "/stereo" : "/8ch")
+                                                + (filter24dB ? "/24dB" : "/12dB")
+                                                + (degrade ? "/degrade" : "/clean")
+                                                + (longDelay ? "/long" : "/short")
+                                                + (perSample ? "/perSample" : "/staged");
+
+                                results.push_back({ name, ns });
+                                report(results.back());
+                            }
+
+        results.push_back({ "readDelay/cubic", timeReadDelay<SampleType, false>() });
+        report(results.back());
+        results.push_back({ "readDelay/sinc", timeReadDelay<SampleType, true>() });
+        report(results.back());
+        results.push_back({ "readSettled/integer", timeReadSettled<SampleType, false>(36000.0f) });
+        report(results.back());
+        results.push_back({ "readSettled/cubic", timeReadSettled<SampleType, false>(36000.37f) });
+        report(results.back());
+        results.push_back({ "readSettled/sinc", timeReadSettled<SampleType, true>(36000.37f) });
+        report(results.back());
+        results.push_back({ "softClip", timeSoftClip<SampleType>() });
+        report(results.back());
+
+        return results;
+    }
+
+private:
+    template <typename SampleType>
+    static void setUp(DubDelay<SampleType>& engine, double sampleRate, int blockSize, int channels,
+                      bool filter24dB, bool degrade, bool longDelay, bool offline)
+    {
+        engine.setRenderQuality(offline ? DubDelay<SampleType>::RenderQuality::offline
+                                        : DubDelay<SampleType>::RenderQuality::realtime);
+        engine.prepare(sampleRate, blockSize, channels);
+        engine.setDelayTime(longDelay ? LONG_DELAY_MS : getShortDelayMs(sampleRate, blockSize), false, 120.0);
+        engine.setFeedback(60.0f);
+        engine.setDegradation(degrade ? 60.0f : 0.0f);
+        engine.setFilterType(filter24dB);
+        engine.setFilterFrequency(1000.0f);
+        engine.setFilterBandwidth(2.0f);
+        engine.setGain(0.0f);
+        engine.setPanLR(20.0f);
+        engine.setPanRL(20.0f);
+        engine.setMix(50.0f);
+        engine.crossfadeDelayTime();
+    }
+
+    static float getShortDelayMs(double sampleRate, int blockSize)
+    {
+        return juce::jlimit(1.0f, SHORT_DELAY_MS, static_cast<float>(500.0 * blockSize / sampleRate));
+    }
+
+    template <typename SampleType>
+    static void fillNoise(juce::AudioBuffer<SampleType>& buffer)
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, static_cast<SampleType>(noise(random)));
+    }
+
+    template <typename SampleType>
+    static double timeProcess(double sampleRate, int blockSize, int channels, bool filter24dB,
+                              bool degrade, bool longDelay, bool offline, bool& perSample)
+    {
+        juce::ScopedNoDenormals noDenormals;
+        DubDelay<SampleType> engine;
+        setUp(engine, sampleRate, blockSize, channels, filter24dB, degrade, longDelay, offline);
+
+        // One second of noise, copied in a block per call (the copy is timed
+        // too, but is small next to the engine)
+        juce::AudioBuffer<SampleType> source(channels, static_cast<int>(sampleRate));
+        fillNoise(source);
+        juce::AudioBuffer<SampleType> block(channels, blockSize);
+        int position = 0;
+
+        const double ns = bestNsPerSample(blockSize, [&]
+        {
+            for (int channel = 0; channel < channels; ++channel)
+                block.copyFrom(channel, 0, source, channel, position, blockSize);
+            position = (position + blockSize) % (source.getNumSamples() - blockSize);
+            engine.process(block);
+        }, static_cast<int>(sampleRate));
+
+        perSample = engine.getLastEnginePath() == DubDelay<SampleType>::EnginePath::perSample;
+        return ns;
+    }
+
+    template <typename SampleType, bool HighQuality>
+    static double timeReadDelay()
+    {
+        juce::ScopedNoDenormals noDenormals;
+        DubDelay<SampleType> engine;
+        setUp(engine, 48000.0, 512, 2, false, false, true, HighQuality);
+
+        // Fill and prime the ring
+        juce::AudioBuffer<SampleType> block(2, 512);
+        for (int i = 0; i < 200; ++i)
+        {
+            fillNoise(block);
+            engine.process(block);
+        }
+
+        const int valid = engine.delayMask + 1;
+        SampleType sink = 0;
+        int writeIndex = 0;
+        float fraction = 0.0f;
+
+        const double ns = bestNsPerSample(256, [&]
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                // Moving fractional delay: no settled-tap shortcut
+                fraction += 0.37f;
+                fraction -= static_cast<float>(static_cast<int>(fraction));
+                writeIndex = (writeIndex + 1) & engine.delayMask;
+                sink += engine.template readDelay<HighQuality>(engine.delayBuffers[0], writeIndex, 36000.0f + fraction, valid);
+            }
+        }, 48000);
+
+        juce::ignoreUnused(sink);
+        return ns;
+    }
+
+    // Settled-delay fast path: one FixedTap at a constant delay, against the
+    // moving-fraction readDelay() cases above (the smoothing path's read)
+    template <typename SampleType, bool HighQuality>
+    static double timeReadSettled(float readTime)
+    {
+        juce::ScopedNoDenormals noDenormals;
+        DubDelay<SampleType> engine;
+        setUp(engine, 48000.0, 512, 2, false, false, true, HighQuality);
+
+        juce::AudioBuffer<SampleType> block(2, 512);
+        for (int i = 0; i < 200; ++i)
+        {
+            fillNoise(block);
+            engine.process(block);
+        }
+
+        const auto tap = engine.makeFixedTap(readTime);
+        const int valid = engine.delayMask + 1;
+        SampleType sink = 0;
+        int writeIndex = 0;
+
+        const double ns = bestNsPerSample(256, [&]
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                writeIndex = (writeIndex + 1) & engine.delayMask;
+                sink += engine.template readSettled<HighQuality>(engine.delayBuffers[0], tap, writeIndex, valid);
+            }
+        }, 48000);
+
+        juce::ignoreUnused(sink);
+        return ns;
+    }
+
+    template <typename SampleType>
+    static double timeSoftClip()
+    {
+        DubDelay<SampleType> engine;
+        std::vector<SampleType> input(4096);
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> drive(-3.0f, 3.0f);
+        for (auto& x : input)
+            x = static_cast<SampleType>(drive(random));
+
+        SampleType sink = 0;
+        const double ns = bestNsPerSample(static_cast<int>(input.size()), [&]
+        {
+            for (auto x : input)
+                sink += engine.softClip(x);
+        }, 48000);
+
+        juce::ignoreUnused(sink);
+        return ns;
+    }
+
+    // Best of REPETITIONS timed runs of samplesPerCall-sample calls, after
+    // warmupSamples of warm-up
+    template <typename Function>
+    static double bestNsPerSample(int samplesPerCall, Function&& call, int warmupSamples)
+    {
+        for (int done = 0; done < warmupSamples; done += samplesPerCall)
+            call();
+
+        double best = std::numeric_limits<double>::max();
+        for (int repetition = 0; repetition < REPETITIONS; ++repetition)
+        {
+            juce::int64 samples = 0;
+            const auto start = juce::Time::getHighResolutionTicks();
+            double seconds = 0.0;
+
+            do
+            {
+                for (int i = 0; i < 16; ++i)
+                    call();
+                samples += 16 * samplesPerCall;
+                seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+            }
+            while (seconds < MIN_SECONDS);
+
+            best = std::min(best, seconds * 1.0e9 / static_cast<double>(samples));
+        }
+
+        return best;
+    }
+
+    static void report(const Result& result)
+    {
+        std::cout << result.name.paddedRight(' ', 60) << juce::String(result.nsPerSample, 2) << " ns/sample\n";
+    }
+
+    static juce::String toJson(const std::vector<Result>& results, bool useDouble, bool offline)
+    {
+        juce::Array<juce::var> list;
+        for (const auto& result : results)
+        {
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("name", result.name);
+            entry->setProperty("nsPerSample", result.nsPerSample);
+            list.add(juce::var(entry));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("version", FORMAT_VERSION);
+        root->setProperty("precision", useDouble ? "double" : "float");
+        root->setProperty("renderQuality", offline ? "offline" : "realtime");
+        root->setProperty("results", list);
+        return juce::JSON::toString(juce::var(root));
+    }
+
+    // Flags cases slower than the baseline by more than tolerance percent
+    static bool compare(const std::vector<Result>& results, const juce::var& baseline, double tolerance,
+                        bool useDouble, bool offline)
+    {
+        if (static_cast<int>(baseline.getProperty("version", 0)) != FORMAT_VERSION)
+        {
+            std::cerr << "baseline is from another benchmark version (cases differ), run it again\n";
+            return false;
+        }
+
+        if (baseline.getProperty("precision", {}).toString() != (useDouble ? "double" : "float")
+            || baseline.getProperty("renderQuality", {}).toString() != (offline ? "offline" : "realtime"))
+        {
+            std::cerr << "baseline was run with other --double/--offline settings\n";
+            return false;
+        }
+
+        auto* entries = baseline.getProperty("results", {}).getArray();
+        if (entries == nullptr)
+        {
+            std::cerr << "baseline has no results\n";
+            return false;
+        }
+
+        std::map<juce::String, double> previous;
+        for (const auto& entry : *entries)
+            previous[entry.getProperty("name", {}).toString()] = static_cast<double>(entry.getProperty("nsPerSample", 0.0));
+
+        int regressions = 0, compared = 0;
+        std::cout << "\nvs baseline (tolerance " << juce::String(tolerance, 1) << "%)\n";
+
+        for (const auto& result : results)
+        {
+            const auto found = previous.find(result.name);
+            if (found == previous.end() || found->second <= 0.0)
+                continue;
+
+            ++compared;
+            const double change = (result.nsPerSample / found->second - 1.0) * 100.0;
+            if (change > tolerance)
+            {
+                ++regressions;
+                std::cout << "REGRESSION " << result.name.paddedRight(' ', 60) << juce::String(found->second, 2)
+                          << " -> " << juce::String(result.nsPerSample, 2) << " ns/sample (+"
+                          << juce::String(change, 1) << "%)\n";
+            }
+        }
+
+        std::cout << compared << " cases compared, " << regressions << " regressions\n";
+        return regressions == 0;
+    }
+};
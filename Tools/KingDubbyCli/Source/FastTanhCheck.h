@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../../../Source/FastTanh.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/**
+ * FastTanhCheck - verifies the FastTanh error bound and output range
+ *
+ * Sweeps +-SWEEP_RANGE in SWEEP_STEP steps (plus the clamp point and
+ * extremes) through the scalar, SIMDRegister and block variants, in float
+ * and double, and compares each against std::tanh evaluated in double.
+ * Fails when any variant exceeds FastTanh::MAX_ERROR, leaves [-1, 1], or
+ * differs from the scalar variant (they share coefficients and must agree
+ * bit for bit).
+ */
+struct FastTanhCheck
+{
+    static constexpr double SWEEP_RANGE = 20.0;
+    static constexpr double SWEEP_STEP = 1.0e-4;
+
+    static int run(const juce::ArgumentList&)
+    {
+        const int failures = check<float>("float") + check<double>("double");
+        std::cout << (failures == 0 ? "FastTanh ok\n" : "FastTanh FAILED\n");
+        return failures == 0 ? 0 : 1;
+    }
+
+private:
+    template <typename ElementType>
+    static std::vector<ElementType> getInputs()
+    {
+        std::vector<ElementType> inputs;
+        const auto steps = static_cast<int>(SWEEP_RANGE / SWEEP_STEP);
+        for (int i = -steps; i <= steps; ++i)
+            inputs.push_back(static_cast<ElementType>(i * SWEEP_STEP));
+
+        // Around the clamp point, where the error peaks, and far outside the sweep
+        for (const auto x : { FastTanh::CLAMP_INPUT, std::nextafter(FastTanh::CLAMP_INPUT, 0.0f),
+                              std::nextafter(FastTanh::CLAMP_INPUT, 10.0f), 1.0e3f, 1.0e30f })
+        {
+            inputs.push_back(static_cast<ElementType>(x));
+            inputs.push_back(static_cast<ElementType>(-x));
+        }
+
+        // Whole registers for the SIMD pass
+        while (inputs.size() % juce::dsp::SIMDRegister<ElementType>::size() != 0)
+            inputs.push_back(ElementType(0));
+
+        return inputs;
+    }
+
+    template <typename ElementType>
+    static int check(const char* precision)
+    {
+        using Reg = juce::dsp::SIMDRegister<ElementType>;
+        const auto inputs = getInputs<ElementType>();
+        const auto count = inputs.size();
+
+        std::vector<ElementType> scalar(count), simd(count), block(inputs);
+        for (size_t i = 0; i < count; ++i)
+            scalar[i] = FastTanh::fast(inputs[i]);
+
+        for (size_t i = 0; i < count; i += Reg::size())
+        {
+            Reg x;
+            for (size_t lane = 0; lane < Reg::size(); ++lane)
+                x.set(lane, inputs[i + lane]);
+
+            x = FastTanh::fast(x);
+            for (size_t lane = 0; lane < Reg::size(); ++lane)
+                simd[i + lane] = x.get(lane);
+        }
+
+        FastTanh::fast(block.data(), static_cast<int>(count));
+
+        int failures = 0;
+        for (const auto& [variant, output] : { std::make_pair("scalar", &scalar),
+                                               std::make_pair("simd", &simd),
+                                               std::make_pair("block", &block) })
+        {
+            double worstError = 0.0, worstInput = 0.0, peak = 0.0;
+            size_t mismatches = 0;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto y = static_cast<double>((*output)[i]);
+                const double error = std::abs(y - std::tanh(static_cast<double>(inputs[i])));
+                if (error > worstError)
+                {
+                    worstError = error;
+                    worstInput = static_cast<double>(inputs[i]);
+                }
+
+                peak = std::max(peak, std::abs(y));
+                if ((*output)[i] != scalar[i])
+                    ++mismatches;
+            }
+
+            const bool ok = worstError <= FastTanh::MAX_ERROR && peak <= 1.0 && mismatches == 0;
+            std::cout << (ok ? "ok   " : "FAIL ") << precision << "/" << variant
+                      << ": max error " << worstError << " at x = " << worstInput
+                      << " (bound " << FastTanh::MAX_ERROR << "), max |y| " << peak;
+            if (mismatches > 0)
+                std::cout << ", " << mismatches << " values differ from scalar";
+            std::cout << "\n";
+
+            if (! ok)
+                ++failures;
+        }
+
+        return failures;
+    }
+};
@@ -0,0 +1,365 @@
+#pragma once
+
+#include "../../../Source/ParameterSnapshot.h"
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/**
+ * GoldenRenders - reference-output regression check for DubDelay
+ *
+ * Renders a fixed grid: every Case (parameter setting and engine) against
+ * every stimulus (impulse, sine sweep, noise bursts and a drum loop, all
+ * synthesised here), stimulus plus TAIL_SECONDS of silence at 48 kHz.
+ *
+ *   --record=DIR   writes one reference file per render
+ *   --check=DIR    renders again and compares against the references
+ *
+ * No reference set is committed (a full one is about 86 MB of floats).
+ * Record one from the current engine before a DSP change and check the
+ * change against it. The references pin down the engine as it was when
+ * they were recorded, not the original pre-optimisation DubDelay: that one
+ * can't be compared sample for sample, as it dropped the first block after
+ * reset() (this engine fades in, so every render is a block apart) and its
+ * hot patches self-oscillate, where any rounding difference grows to full
+ * scale. Changes that are meant to move the output (the FastTanh kernel,
+ * the bandpass bank) are checked on their own by --check-tanh and
+ * --check-bandpass; record new references after such a change.
+ *
+ * A reference stores the build flavour it was rendered with (the
+ * KINGDUBBY_FAST_TANH kernel and the SIMD width). Checked by the same
+ * flavour, a render must be bit-exact; across flavours (fast-math tanh vs
+ * std::tanh, another SIMD width) each case allows its own maximum absolute
+ * error, sized for how much its loop compounds a small difference.
+ */
+struct GoldenRenders
+{
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr double STIMULUS_SECONDS = 2.0;
+    static constexpr double TAIL_SECONDS = 2.0;
+    static constexpr int FILE_MAGIC = 0x5247444b;  // "KDGR"
+    static constexpr int FILE_VERSION = 1;
+
+    struct Case
+    {
+        const char* name;
+        float tolerance;            // Max abs error across build flavours
+        bool useDouble;
+        bool offline;               // Offline render tier (double engine only in the plugin)
+        int blockSize;
+        std::function<void(ParameterSnapshot&)> setUp;
+    };
+
+    struct Stimulus
+    {
+        const char* name;
+        std::function<void(juce::AudioBuffer<float>&)> generate;
+    };
+
+    static int run(const juce::ArgumentList& args)
+    {
+        const bool record = args.containsOption("--record");
+        if (record == args.containsOption("--check"))
+        {
+            std::cerr << "Give either --record=DIR or --check=DIR\n";
+            return 1;
+        }
+
+        const auto directory = juce::File::getCurrentWorkingDirectory()
+                                   .getChildFile(args.getValueForOption(record ? "--record" : "--check"));
+        if (record && ! directory.createDirectory().wasOk())
+        {
+            std::cerr << "can't create " << directory.getFullPathName() << "\n";
+            return 1;
+        }
+
+        const auto filter = args.getValueForOption("--case");
+        int failures = 0, renders = 0;
+
+        for (const auto& stimulus : getStimuli())
+        {
+            juce::AudioBuffer<float> input(2, static_cast<int>(STIMULUS_SECONDS * SAMPLE_RATE));
+            input.clear();
+            stimulus.generate(input);
+
+            for (const auto& c : getCases())
+            {
+                const auto name = juce::String(c.name) + "__" + stimulus.name;
+                if (filter.isNotEmpty() && ! name.contains(filter))
+                    continue;
+
+                ++renders;
+                const auto output = c.useDouble ? render<double>(c, input) : render<float>(c, input);
+                const auto file = directory.getChildFile(name + ".kdgr");
+
+                if (record)
+                {
+                    if (! writeReference(file, output))
+                    {
+                        std::cerr << "can't write " << file.getFullPathName() << "\n";
+                        ++failures;
+                    }
+                }
+                else if (! check(name, c, output, file))
+                {
+                    ++failures;
+                }
+            }
+        }
+
+        std::cout << "\n" << renders << " renders, " << failures << (record ? " write errors\n" : " failures\n");
+        return failures == 0 ? 0 : 1;
+    }
+
+private:
+    //==============================================================================
+    // Grid
+
+    static const std::vector<Case>& getCases()
+    {
+        static const std::vector<Case> cases
+        {
+            { "default",        2.0e-3f, false, false,  512, [] (ParameterSnapshot&) {} },
+            { "hotFeedback",    5.0e-2f, false, false,  512, [] (ParameterSnapshot& p) { p.feedback = 95.0f; } },
+            { "filter24dB",     5.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.filter24dB = true; p.filterFreq = 800.0f; p.filterBandwidth = 3.0f; } },
+            { "fullDegrade",    2.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.degradation = 100.0f; } },
+            { "pingPong",       2.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.panLR = 100.0f; p.panRL = 100.0f; } },
+            { "hotDub",         5.0e-2f, false, false,  512, [] (ParameterSnapshot& p) { p.feedback = 90.0f; p.filter24dB = true;
+                                                                                           p.degradation = 100.0f; p.panLR = 100.0f; p.panRL = 100.0f; } },
+            { "shortDelay",     2.0e-3f, false, false, 2048, [] (ParameterSnapshot& p) { p.time = 1.0f; } },  // Per-sample engine
+            { "multiTap",       2.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.taps[0] = { 12.0f, 70.0f, 0.0f };
+                                                                                           p.taps[1] = { 36.0f, 50.0f, 100.0f }; } },
+            { "wowFlutter",     2.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.wowDepth = 60.0f; p.wowRate = 40.0f; p.wowDrift = 30.0f; } },
+            { "biquad",         2.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.filterTopology = 1; } },
+            { "adaa",           5.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.feedback = 85.0f; p.saturationQuality = 1; } },
+            { "oversample4x",   5.0e-3f, false, false,  512, [] (ParameterSnapshot& p) { p.feedback = 85.0f; p.saturationQuality = 3; } },
+            { "double",         2.0e-3f, true,  false,  512, [] (ParameterSnapshot&) {} },
+            { "offline",        2.0e-3f, true,  true,   512, [] (ParameterSnapshot&) {} }
+        };
+
+        return cases;
+    }
+
+    static const std::vector<Stimulus>& getStimuli()
+    {
+        static const std::vector<Stimulus> stimuli
+        {
+            { "impulse", [] (juce::AudioBuffer<float>& b)
+              {
+                  // Left at 0, right a quarter second later (shows the crossfeed)
+                  b.setSample(0, 0, 1.0f);
+                  b.setSample(1, static_cast<int>(0.25 * SAMPLE_RATE), 1.0f);
+              } },
+
+            { "sweep", [] (juce::AudioBuffer<float>& b)
+              {
+                  // Exponential 20 Hz - 20 kHz at -6 dBFS
+                  const double length = b.getNumSamples() / SAMPLE_RATE;
+                  const double rate = std::log(20000.0 / 20.0);
+                  for (int i = 0; i < b.getNumSamples(); ++i)
+                  {
+                      const double t = i / SAMPLE_RATE;
+                      const double phase = juce::MathConstants<double>::twoPi * 20.0 * length / rate * (std::exp(t / length * rate) - 1.0);
+                      const auto value = static_cast<float>(0.5 * std::sin(phase));
+                      b.setSample(0, i, value);
+                      b.setSample(1, i, value);
+                  }
+              } },
+
+            { "noiseBursts", [] (juce::AudioBuffer<float>& b)
+              {
+                  // 40 ms white noise every 500 ms, 1 ms ramps
+                  juce::uint32 seed = 1;
+                  const int length = static_cast<int>(0.04 * SAMPLE_RATE);
+                  const int ramp = static_cast<int>(0.001 * SAMPLE_RATE);
+                  for (int start = 0; start + length < b.getNumSamples(); start += static_cast<int>(0.5 * SAMPLE_RATE))
+                      for (int i = 0; i < length; ++i)
+                      {
+                          const float envelope = static_cast<float>(std::min({ i, length - 1 - i, ramp })) / static_cast<float>(ramp);
+                          for (int channel = 0; channel < 2; ++channel)
+                              b.setSample(channel, start + i, 0.5f * envelope * noise(seed));
+                      }
+              } },
+
+            { "drumLoop", [] (juce::AudioBuffer<float>& b)
+              {
+                  // One bar at 120 bpm: kick on 1 and 3, snare on 2 and 4, eighth-note hats
+                  juce::uint32 seed = 7;
+                  const int beat = static_cast<int>(0.5 * SAMPLE_RATE);
+                  for (int eighth = 0; eighth * beat / 2 < b.getNumSamples(); ++eighth)
+                  {
+                      const int start = eighth * beat / 2;
+                      const bool onBeat = eighth % 2 == 0;
+                      const int beatIndex = eighth / 2;
+                      float previousNoise = 0.0f;
+
+                      for (int i = 0; start + i < b.getNumSamples() && i < beat / 2; ++i)
+                      {
+                          const double t = i / SAMPLE_RATE;
+                          const float white = noise(seed);
+                          float left = 0.0f, right = 0.0f;
+
+                          if (onBeat && beatIndex % 2 == 0)
+                          {
+                              // Kick: 150 -> 50 Hz pitch drop
+                              const double phase = juce::MathConstants<double>::twoPi * (50.0 * t + 100.0 / 30.0 * (1.0 - std::exp(-30.0 * t)));
+                              const auto kick = static_cast<float>(0.8 * std::sin(phase) * std::exp(-8.0 * t));
+                              left += kick;
+                              right += kick;
+                          }
+                          else if (onBeat)
+                          {
+                              const auto snare = static_cast<float>(0.4 * white * std::exp(-20.0 * t)
+                                                                  + 0.3 * std::sin(juce::MathConstants<double>::twoPi * 180.0 * t) * std::exp(-15.0 * t));
+                              left += snare;
+                              right += snare;
+                          }
+
+                          // Hat: differentiated noise, panned right
+                          const auto hat = static_cast<float>(0.2 * (white - previousNoise) * std::exp(-60.0 * t));
+                          previousNoise = white;
+                          left += 0.6f * hat;
+                          right += hat;
+
+                          b.setSample(0, start + i, left);
+                          b.setSample(1, start + i, right);
+                      }
+                  }
+              } }
+        };
+
+        return stimuli;
+    }
+
+    // Deterministic white noise in [-1, 1) (LCG, same on every platform)
+    static float noise(juce::uint32& seed) noexcept
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+    //==============================================================================
+    // Rendering
+
+    template <typename SampleType>
+    static juce::AudioBuffer<float> render(const Case& c, const juce::AudioBuffer<float>& input)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        ParameterSnapshot parameters;
+        c.setUp(parameters);
+
+        DubDelay<SampleType> engine;
+        engine.setRenderQuality(c.offline ? DubDelay<SampleType>::RenderQuality::offline
+                                          : DubDelay<SampleType>::RenderQuality::realtime);
+        engine.prepare(SAMPLE_RATE, c.blockSize);
+        parameters.applyTo(engine, 120.0);
+        engine.crossfadeDelayTime();
+
+        const int length = input.getNumSamples() + static_cast<int>(TAIL_SECONDS * SAMPLE_RATE);
+        juce::AudioBuffer<float> output(2, length);
+        juce::AudioBuffer<SampleType> block(2, c.blockSize);
+
+        for (int start = 0; start < length; start += c.blockSize)
+        {
+            const int numSamples = std::min(c.blockSize, length - start);
+            block.setSize(2, numSamples, false, false, true);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    block.setSample(channel, i, start + i < input.getNumSamples()
+                                                    ? static_cast<SampleType>(input.getSample(channel, start + i))
+                                                    : SampleType(0));
+
+            engine.process(block);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    output.setSample(channel, start + i, static_cast<float>(block.getSample(channel, i)));
+        }
+
+        return output;
+    }
+
+    //==============================================================================
+    // Reference files: header ints, then each channel's floats (little-endian)
+
+    static int getFastTanhFlag() { return KINGDUBBY_FAST_TANH; }
+    static int getSimdLanes() { return static_cast<int>(juce::dsp::SIMDRegister<float>::size()); }
+
+    static bool writeReference(const juce::File& file, const juce::AudioBuffer<float>& output)
+    {
+        if (! file.deleteFile())
+            return false;
+
+        juce::FileOutputStream stream(file);
+        if (! stream.openedOk())
+            return false;
+
+        stream.writeInt(FILE_MAGIC);
+        stream.writeInt(FILE_VERSION);
+        stream.writeInt(static_cast<int>(SAMPLE_RATE));
+        stream.writeInt(output.getNumChannels());
+        stream.writeInt(output.getNumSamples());
+        stream.writeInt(getFastTanhFlag());
+        stream.writeInt(getSimdLanes());
+
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+            for (int i = 0; i < output.getNumSamples(); ++i)
+                stream.writeFloat(output.getSample(channel, i));
+
+        stream.flush();
+        return stream.getStatus().wasOk();
+    }
+
+    static bool check(const juce::String& name, const Case& c, const juce::AudioBuffer<float>& output, const juce::File& file)
+    {
+        juce::FileInputStream stream(file);
+        if (! stream.openedOk() || stream.readInt() != FILE_MAGIC || stream.readInt() != FILE_VERSION)
+            return fail(name, "no reference (record one with --record)");
+
+        const int sampleRate = stream.readInt();
+        const int numChannels = stream.readInt();
+        const int numSamples = stream.readInt();
+        const int fastTanh = stream.readInt();
+        const int simdLanes = stream.readInt();
+        const bool sameFlavour = fastTanh == getFastTanhFlag() && simdLanes == getSimdLanes();
+
+        if (sampleRate != static_cast<int>(SAMPLE_RATE) || numChannels != output.getNumChannels()
+            || numSamples != output.getNumSamples())
+            return fail(name, "reference has a different length or layout");
+
+        double maxError = 0.0;
+        int mismatches = 0;
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float reference = stream.readFloat();
+                const float value = output.getSample(channel, i);
+                if (! std::isfinite(value))
+                    return fail(name, "non-finite output");
+
+                if (value != reference)
+                {
+                    ++mismatches;
+                    maxError = std::max(maxError, std::abs(static_cast<double>(value) - reference));
+                }
+            }
+
+        const bool passed = sameFlavour ? mismatches == 0 : maxError <= c.tolerance;
+        std::cout << (passed ? "ok    " : "FAIL  ") << name.paddedRight(' ', 32)
+                  << (sameFlavour ? "bit-exact  " : "bounded    ")
+                  << (mismatches == 0 ? juce::String("identical")
+                                      : juce::String(mismatches) + " samples differ, max "
+                                          + juce::String(maxError, 7) + " (limit "
+                                          + (sameFlavour ? juce::String("0") : juce::String(c.tolerance, 4)) + ")")
+                  << "\n";
+        return passed;
+    }
+
+    static bool fail(const juce::String& name, const char* reason)
+    {
+        std::cout << "FAIL  " << name.paddedRight(' ', 32) << reason << "\n";
+        return false;
+    }
+};
@@ -0,0 +1,107 @@
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "StateBenchmark.h"
+#include "BatchRender.h"
+#include "DubDelayBenchmark.h"
+#include "GoldenRenders.h"
+#include "FastTanhCheck.h"
+#include "BandpassResponseCheck.h"
+
+/**
+ * KingDubbyCli - command-line tools around the plugin sources
+ *
+ * Runs the processor and DubDelay outside a host. Usage:
+ *   KingDubbyCli --help
+ *   KingDubbyCli --state-bench [--instances=200] [--rounds=20]
+ *   KingDubbyCli --render [options] file...
+ *   KingDubbyCli --bench [--out=FILE] [--baseline=FILE] [options]
+ *   KingDubbyCli --golden --record=DIR|--check=DIR [--case=NAME]
+ *   KingDubbyCli --check-tanh
+ *   KingDubbyCli --check-bandpass
+ */
+int main(int argc, char* argv[])
+{
+    // Processors and their parameter trees expect a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "KingDubby command-line tools", true);
+
+    app.addCommand({ "--state-bench",
+                     "--state-bench [--instances=N] [--rounds=N]",
+                     "Compares session state save/load throughput: binary vs XML",
+                     "Times getStateInformation()/setStateInformation() over N randomised instances, "
+                     "against the XML state format used before the binary one.",
+                     [] (const juce::ArgumentList& args)
+                     {
+                         if (StateBenchmark::run(args) != 0)
+                             juce::ConsoleApplication::fail("State round trip failed");
+                     } });
+
+    app.addCommand({ "--render",
+                     "--render [--preset=NAME|--state=FILE] [--set=ID=VALUE,...] [options] file...",
+                     "Renders WAV/AIFF files (1-8 channels) through DubDelay, tail included",
+                     "Parameters: a factory program (name or index) or a saved plugin state, then per-ID overrides.\n"
+                     "Options: --bpm=120 --block=512 --threads=N (default: one per core) --max-tail=30 (seconds)\n"
+                     "         --bits=24|16 --out=DIR (default: next to the input, as NAME_dub.wav; inputs that\n"
+                     "         would share an output file are refused)\n"
+                     "         --realtime (float engine, realtime tier; default is the offline tier)\n"
+                     "         --verify (render again on one thread and compare)",
+                     [] (const juce::ArgumentList& args)
+                     {
+                         if (BatchRender::run(args) != 0)
+                             juce::ConsoleApplication::fail("Render failed");
+                     } });
+
+    app.addCommand({ "--bench",
+                     "--bench [--out=FILE.json] [--baseline=FILE.json] [--tolerance=10] [--quick] [--double] [--offline]",
+                     "Times DubDelay (ns/sample) over a parameter grid, plus readDelay(), readSettled() and softClip()",
+                     "Grid: 44.1-192 kHz, blocks of 1-4096, mono/stereo/8 channels, 12/24 dB, degradation off/on, short/long delay\n"
+                     "(process cases are named after the engine that ran: /staged or /perSample).\n"
+                     "--out writes the results as JSON; --baseline compares against an earlier file and fails\n"
+                     "when a case is slower by more than --tolerance percent. --quick runs a reduced grid;\n"
+                     "--double and --offline select the double engine and the offline render tier.",
+                     [] (const juce::ArgumentList& args)
+                     {
+                         if (DubDelayBenchmark::run(args) != 0)
+                             juce::ConsoleApplication::fail("Benchmark regressions");
+                     } });
+
+    app.addCommand({ "--golden",
+                     "--golden --record=DIR|--check=DIR [--case=NAME]",
+                     "Checks DubDelay output against stored reference renders",
+                     "Renders impulses, a sweep, noise bursts and a drum loop through a grid of settings (hot feedback,\n"
+                     "24 dB, full degradation, ping-pong, ...). --record writes the references; --check compares:\n"
+                     "bit-exact on the build flavour they were recorded with, within each case's error bound on another\n"
+                     "(KINGDUBBY_FAST_TANH, SIMD width). --case only runs renders whose name contains NAME.",
+                     [] (const juce::ArgumentList& args)
+                     {
+                         if (GoldenRenders::run(args) != 0)
+                             juce::ConsoleApplication::fail("Golden renders differ");
+                     } });
+
+    app.addCommand({ "--check-tanh",
+                     "--check-tanh",
+                     "Checks the FastTanh softclip kernel against std::tanh",
+                     "Sweeps the scalar, SIMD and block variants (float and double) and fails when any exceeds the\n"
+                     "documented maximum error, leaves [-1, 1] or differs from the scalar variant.",
+                     [] (const juce::ArgumentList& args)
+                     {
+                         if (FastTanhCheck::run(args) != 0)
+                             juce::ConsoleApplication::fail("FastTanh out of bounds");
+                     } });
+
+    app.addCommand({ "--check-bandpass",
+                     "--check-bandpass",
+                     "Checks the BandpassBank frequency response against the StateVariableTPTFilter it replaced",
+                     "Compares the SVF and biquad topologies (float and double) with cascaded StateVariableTPTFilter\n"
+                     "bandpass stages over 44.1-192 kHz, FREQ, BANDW and 12/24 dB, wherever the old response is\n"
+                     "above -40 dB; fails beyond 0.11 dB (float) or 0.0001 dB (double).",
+                     [] (const juce::ArgumentList& args)
+                     {
+                         if (BandpassResponseCheck::run(args) != 0)
+                             juce::ConsoleApplication::fail("Bandpass response out of tolerance");
+                     } });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../../../Source/PluginProcessor.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * StateBenchmark - session save/load throughput, binary state vs XML
+ *
+ * Builds a session of processors with randomised parameters and times
+ * getStateInformation()/setStateInformation() across all of them, against
+ * the XML path the plugin used before BinaryState (copyState() ->
+ * createXml() -> copyXmlToBinary(), loaded back through the XML fallback).
+ * Finishes by round-tripping one binary state into a fresh instance.
+ */
+struct StateBenchmark
+{
+    static int run(const juce::ArgumentList& args)
+    {
+        const int instances = getIntOption(args, "--instances", 200);
+        const int rounds = getIntOption(args, "--rounds", 20);
+
+        std::mt19937 random(2024);
+        std::vector<std::unique_ptr<KingDubbyAudioProcessor>> session;
+        for (int i = 0; i < instances; ++i)
+        {
+            session.push_back(std::make_unique<KingDubbyAudioProcessor>());
+            randomise(*session.back(), random);
+        }
+
+        std::vector<juce::MemoryBlock> binary(static_cast<size_t>(instances));
+        std::vector<juce::MemoryBlock> xml(static_cast<size_t>(instances));
+
+        const double binarySave = secondsPerRound(rounds, [&]
+        {
+            for (size_t i = 0; i < session.size(); ++i)
+                session[i]->getStateInformation(binary[i]);
+        });
+
+        const double xmlSave = secondsPerRound(rounds, [&]
+        {
+            for (size_t i = 0; i < session.size(); ++i)
+                writeXmlState(*session[i], xml[i]);
+        });
+
+        const double binaryLoad = secondsPerRound(rounds, [&]
+        {
+            for (size_t i = 0; i < session.size(); ++i)
+                session[i]->setStateInformation(binary[i].getData(), static_cast<int>(binary[i].getSize()));
+        });
+
+        const double xmlLoad = secondsPerRound(rounds, [&]
+        {
+            for (size_t i = 0; i < session.size(); ++i)
+                session[i]->setStateInformation(xml[i].getData(), static_cast<int>(xml[i].getSize()));
+        });
+
+        std::cout << instances << " instances, " << rounds << " rounds\n\n"
+                  << "format    bytes/state   save (states/s)   load (states/s)\n";
+        report("xml", xml.front().getSize(), instances, xmlSave, xmlLoad);
+        report("binary", binary.front().getSize(), instances, binarySave, binaryLoad);
+        std::cout << "\nspeedup   save " << juce::String(xmlSave / binarySave, 1)
+                  << "x, load " << juce::String(xmlLoad / binaryLoad, 1) << "x\n";
+
+        // The binary state has to carry everything the XML one did
+        KingDubbyAudioProcessor restored;
+        restored.setStateInformation(binary.front().getData(), static_cast<int>(binary.front().getSize()));
+        const int mismatches = countMismatches(*session.front(), restored);
+        std::cout << "round trip: " << (mismatches == 0 ? juce::String("ok") : juce::String(mismatches) + " parameters differ") << "\n";
+
+        return mismatches == 0 ? 0 : 1;
+    }
+
+    // What getStateInformation() wrote before the binary format
+    static void writeXmlState(KingDubbyAudioProcessor& processor, juce::MemoryBlock& destData)
+    {
+        auto state = processor.getAPVTS().copyState();
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    }
+
+    static void randomise(KingDubbyAudioProcessor& processor, std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> value(0.0f, 1.0f);
+        for (auto* parameter : processor.getParameters())
+            parameter->setValueNotifyingHost(value(random));
+    }
+
+    static int countMismatches(KingDubbyAudioProcessor& a, KingDubbyAudioProcessor& b)
+    {
+        const auto& parametersA = a.getParameters();
+        const auto& parametersB = b.getParameters();
+        int mismatches = 0;
+
+        // Plain values go through convertTo0to1() on the way back in
+        for (int i = 0; i < parametersA.size(); ++i)
+            if (std::abs(parametersA[i]->getValue() - parametersB[i]->getValue()) > 1.0e-6f)
+                ++mismatches;
+
+        return mismatches;
+    }
+
+    template <typename Function>
+    static double secondsPerRound(int rounds, Function&& function)
+    {
+        function();  // Warm up allocators and caches
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        for (int round = 0; round < rounds; ++round)
+            function();
+
+        return (juce::Time::getMillisecondCounterHiRes() - start) * 0.001 / rounds;
+    }
+
+    static void report(const char* format, size_t bytes, int instances, double saveSeconds, double loadSeconds)
+    {
+        std::cout << juce::String(format).paddedRight(' ', 10)
+                  << juce::String(static_cast<juce::int64>(bytes)).paddedRight(' ', 14)
+                  << juce::String(instances / saveSeconds, 0).paddedRight(' ', 18)
+                  << juce::String(instances / loadSeconds, 0) << "\n";
+    }
+
+    static int getIntOption(const juce::ArgumentList& args, const juce::String& option, int defaultValue)
+    {
+        const auto value = args.getValueForOption(option);
+        return value.isNotEmpty() ? juce::jmax(1, value.getIntValue()) : defaultValue;
+    }
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * WorkStealingPool - runs a fixed batch of independent jobs on N threads
+ *
+ * Jobs are dealt round-robin, in the order given, onto one deque per worker.
+ * A worker takes from the front of its own deque and, once that is empty,
+ * steals from the back of the others', so a few long jobs don't leave the
+ * rest of the pool idle. Give the jobs longest first: owners then start on
+ * the long ones and thieves pick off the short ones.
+ *
+ * No jobs are added while a batch runs, so a worker that finds every deque
+ * empty is done. run() returns once all jobs have finished.
+ */
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int numWorkers)
+        : workers(static_cast<size_t>(std::max(1, numWorkers)))
+    {
+    }
+
+    int getNumWorkers() const { return static_cast<int>(workers); }
+
+    // job(index, worker) for every index in [0, numJobs)
+    void run(int numJobs, const std::function<void(int job, int worker)>& job)
+    {
+        std::vector<Queue> queues(workers);
+        for (int i = 0; i < numJobs; ++i)
+            queues[static_cast<size_t>(i) % workers].jobs.push_back(i);
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+
+        for (size_t worker = 0; worker < workers; ++worker)
+        {
+            threads.emplace_back([&queues, &job, worker]
+            {
+                int next = 0;
+                while (takeJob(queues, worker, next))
+                    job(next, static_cast<int>(worker));
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<int> jobs;
+    };
+
+    static bool takeJob(std::vector<Queue>& queues, size_t self, int& job)
+    {
+        {
+            auto& own = queues[self];
+            const std::lock_guard<std::mutex> guard(own.lock);
+            if (! own.jobs.empty())
+            {
+                job = own.jobs.front();
+                own.jobs.pop_front();
+                return true;
+            }
+        }
+
+        for (size_t offset = 1; offset < queues.size(); ++offset)
+        {
+            auto& victim = queues[(self + offset) % queues.size()];
+            const std::lock_guard<std::mutex> guard(victim.lock);
+            if (! victim.jobs.empty())
+            {
+                job = victim.jobs.back();
+                victim.jobs.pop_back();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t workers;
+};